@@ -50,6 +50,23 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 	#define MAX_PATH				MAX_QPATH
 #endif
 
+//bsp tree node packed together with a copy of its plane so a tree
+//walk touches a single cache line per node
+typedef struct aas_packednode_s
+{
+	aas_plane_t plane;					//copy of aasworld.planes[node.planenum]
+	aas_node_t node;					//copy of aasworld.nodes[nodenum]
+} aas_packednode_t;
+
+//cached result of a point to area lookup
+typedef struct aas_pointareacache_s
+{
+	vec3_t point;
+	int areanum;						//-1 if the slot is empty
+} aas_pointareacache_t;
+
+#define POINTAREACACHE_SIZE		1024	//must be a power of two
+
 //string index (for model, sound and image index)
 typedef struct aas_stringindex_s
 {
@@ -151,12 +168,22 @@ typedef struct aas_routingcache_s
 	vec3_t origin;								//origin within the area
 	float starttraveltime;						//travel time to start with
 	int travelflags;							//combinations of the travel flags
+	int hits;									//number of times the cache was reused
+	int buildcost;								//number of routing updates to build the cache
 	struct aas_routingcache_s *prev, *next;
 	struct aas_routingcache_s *time_prev, *time_next;
 	unsigned char *reachabilities;				//reachabilities used for routing
-	unsigned short int traveltimes[1];			//travel time for every area (variable sized)
+	unsigned short int *traveltimes;			//travel time for every area
 } aas_routingcache_t;
 
+//routing cache statistics per goal area
+typedef struct aas_areacachestats_s
+{
+	int evicted;								//(1 << type) for caches evicted and not yet rebuilt
+	int rebuilds;								//number of caches rebuilt after eviction
+	int rebuildcost;							//routing updates spent on rebuilding
+} aas_areacachestats_t;
+
 //fields for the routing algorithm
 typedef struct aas_routingupdate_s
 {
@@ -236,6 +263,10 @@ typedef struct aas_s
 	//nodes of the bsp tree
 	int numnodes;
 	aas_node_t *nodes;
+	//nodes packed with their planes (built after loading, NULL in the bspc)
+	aas_packednode_t *packednodes;
+	//direct mapped cache with point to area lookups
+	aas_pointareacache_t *pointareacache;
 	//cluster portals
 	int numportals;
 	aas_portal_t *portals;
@@ -279,6 +310,10 @@ typedef struct aas_s
 	//cache list sorted on time
 	aas_routingcache_t *oldestcache;		// start of cache list sorted on time
 	aas_routingcache_t *newestcache;		// end of cache list sorted on time
+	//routing cache data read from the route cache file
+	void *routecachedata;
+	//routing cache statistics for every area
+	aas_areacachestats_t *areacachestats;
 	//maximum travel time through portal areas
 	int *portalmaxtraveltimes;
 	//areas the reachabilities go through
@@ -62,7 +62,7 @@ enum {
 //===========================================================================
 int AAS_UpdateEntity(int entnum, bot_entitystate_t *state)
 {
-	int relink;
+	int relink, oldsolid, oldmodelindex;
 	aas_entity_t *ent;
 	vec3_t absmins, absmaxs;
 
@@ -92,6 +92,8 @@ int AAS_UpdateEntity(int entnum, bot_entitystate_t *state)
 	ent->i.ltime = AAS_Time();
 	VectorCopy(ent->i.origin, ent->i.lastvisorigin);
 	VectorCopy(state->old_origin, ent->i.old_origin);
+	oldsolid = ent->i.solid;
+	oldmodelindex = ent->i.modelindex;
 	ent->i.solid = state->solid;
 	ent->i.groundent = state->groundent;
 	ent->i.modelindex = state->modelindex;
@@ -119,9 +121,12 @@ int AAS_UpdateEntity(int entnum, bot_entitystate_t *state)
 			VectorCopy(state->angles, ent->i.angles);
 			relink = qtrue;
 		} //end if
-		//get the mins and maxs of the model
+		//get the mins and maxs of the model, they only change with the model and angles
 		//FIXME: rotate mins and maxs
-		AAS_BSPModelMinsMaxsOrigin(ent->i.modelindex, ent->i.angles, ent->i.mins, ent->i.maxs, NULL);
+		if (relink || oldsolid != SOLID_BSP || oldmodelindex != ent->i.modelindex)
+		{
+			AAS_BSPModelMinsMaxsOrigin(ent->i.modelindex, ent->i.angles, ent->i.mins, ent->i.maxs, NULL);
+		} //end if
 	} //end if
 	else if (ent->i.solid == SOLID_BBOX)
 	{
@@ -163,6 +168,50 @@ int AAS_UpdateEntity(int entnum, bot_entitystate_t *state)
 	return BLERR_NOERROR;
 } //end of the function AAS_UpdateEntity
 //===========================================================================
+// updates all the listed entities with one call, every entity that is
+// not listed is unlinked just like when updated without a state
+//
+// Parameter:			numentities	: number of listed entities
+//						entnums		: numbers of the listed entities
+//						states		: states of the listed entities
+// Returns:				BLERR_
+// Changes Globals:		-
+//===========================================================================
+int AAS_UpdateEntities(int numentities, int *entnums, bot_entitystate_t *states)
+{
+	int i, errnum;
+	aas_entity_t *ent;
+
+	if (!aasworld.loaded)
+	{
+		botimport.Print(PRT_MESSAGE, "AAS_UpdateEntities: not loaded\n");
+		return BLERR_NOAASFILE;
+	} //end if
+	//
+	for (i = 0; i < numentities; i++)
+	{
+		errnum = AAS_UpdateEntity(entnums[i], &states[i]);
+		if (errnum != BLERR_NOERROR) return errnum;
+	} //end for
+	//the entities are invalidated at the start of every frame so the ones
+	//still invalid were not listed
+	for (i = 0; i < aasworld.maxentities; i++)
+	{
+		ent = &aasworld.entities[i];
+		if (ent->i.valid) continue;
+		if (!ent->areas && !ent->leaves) continue;
+		//unlink the entity
+		AAS_UnlinkFromAreas(ent->areas);
+		//unlink the entity from the BSP leaves
+		AAS_UnlinkFromBSPLeaves(ent->leaves);
+		//
+		ent->areas = NULL;
+		//
+		ent->leaves = NULL;
+	} //end for
+	return BLERR_NOERROR;
+} //end of the function AAS_UpdateEntities
+//===========================================================================
 //
 // Parameter:			-
 // Returns:				-
@@ -38,6 +38,8 @@ void AAS_UnlinkInvalidEntities(void);
 void AAS_ResetEntityLinks(void);
 //updates an entity
 int AAS_UpdateEntity(int ent, bot_entitystate_t *state);
+//updates the listed entities and unlinks all the other entities
+int AAS_UpdateEntities(int numentities, int *entnums, bot_entitystate_t *states);
 //gives the entity data used for collision detection
 void AAS_EntityBSPData(int entnum, bsp_entdata_t *entdata);
 #endif //AASINTERN
@@ -264,10 +264,30 @@ int AAS_StartFrame(float time)
 			PrintMemoryLabels();
 			LibVarSet("memorydump", "0");
 		} //end if
+		if (LibVarGetValue("benchmarkrouting"))
+		{
+			AAS_RoutingBenchmark();
+			LibVarSet("benchmarkrouting", "0");
+		} //end if
+	} //end if
+	//
+	predictionstatsframes++;
+	if (LibVarGetValue("predictionstats"))
+	{
+		AAS_MovementPredictionStats();
+		LibVarSet("predictionstats", "0");
+	} //end if
+	//
+	if (LibVarGetValue("routingcachestats"))
+	{
+		AAS_RoutingCacheStats();
+		LibVarSet("routingcachestats", "0");
 	} //end if
 	//
 	if (saveroutingcache->value)
 	{
+		//precalculate all the routing cache before writing it
+		if (saveroutingcache->value > 1) AAS_CreateAllRoutingCache();
 		AAS_WriteRouteCache();
 		LibVarSet("saveroutingcache", "0");
 	} //end if
@@ -366,6 +386,8 @@ int AAS_LoadMap(const char *mapname)
 	AAS_InitAASLinkHeap();
 	//initialize the AAS linked entities for the new map
 	AAS_InitAASLinkedEntities();
+	//pack the bsp tree nodes together with their planes
+	AAS_InitPackedNodes();
 	//initialize reachability for the new map
 	AAS_InitReachability();
 	//initialize the alternative routing
@@ -45,6 +45,14 @@ extern botlib_import_t botimport;
 
 aas_settings_t aassettings;
 
+//movement prediction statistics since the last time they were printed
+int numpredictions;				//number of predicted movements
+int numpredictionbatches;		//number of batches with candidate movements
+int numpredictionframes;		//number of predicted frames
+int numpredictiontraces;		//number of bounding box traces done while predicting
+int numsharedstarttests;		//start point tests shared between candidate movements
+int predictionstatsframes;		//number of AAS frames the statistics were gathered over
+
 //#define AAS_MOVE_DEBUG
 
 //===========================================================================
@@ -499,6 +507,8 @@ int AAS_ClipToBBox(aas_trace_t *trace, vec3_t start, vec3_t end, int presencetyp
 //						frametime		: duration of one predicted frame
 //						stopevent		: events that stop the prediction
 //						stopareanum		: stop as soon as entered this area
+//						startswimming	: if not NULL and >= 0 the swimming state
+//										  at the origin, otherwise it is stored
 // Returns:				aas_clientmove_t
 // Changes Globals:		-
 //===========================================================================
@@ -509,7 +519,8 @@ int AAS_ClientMovementPrediction(struct aas_clientmove_s *move,
 								int cmdframes,
 								int maxframes, float frametime,
 								int stopevent, int stopareanum,
-								vec3_t mins, vec3_t maxs, int visualize)
+								vec3_t mins, vec3_t maxs, int visualize,
+								int *startswimming)
 {
 	float phys_friction, phys_stopspeed, phys_gravity, phys_waterfriction;
 	float phys_watergravity;
@@ -553,10 +564,22 @@ int AAS_ClientMovementPrediction(struct aas_clientmove_s *move,
 	VectorScale(velocity, frametime, frame_test_vel);
 	//
 	jump_frame = -1;
+	numpredictions++;
 	//predict a maximum of 'maxframes' ahead
 	for (n = 0; n < maxframes; n++)
 	{
-		swimming = AAS_Swimming(org);
+		numpredictionframes++;
+		//the start point test can be shared between candidate movements
+		if (!n && startswimming && *startswimming >= 0)
+		{
+			swimming = *startswimming;
+			numsharedstarttests++;
+		} //end if
+		else
+		{
+			swimming = AAS_Swimming(org);
+			if (!n && startswimming) *startswimming = swimming;
+		} //end else
 		//get gravity depending on swimming or not
 		gravity = swimming ? phys_watergravity : phys_gravity;
 		//apply gravity at the START of the frame
@@ -651,6 +674,7 @@ int AAS_ClientMovementPrediction(struct aas_clientmove_s *move,
 			VectorAdd(org, left_test_vel, end);
 			//trace a bounding box
 			trace = AAS_TraceClientBBox(org, end, presencetype, entnum);
+			numpredictiontraces++;
 			//
 //#ifdef AAS_MOVE_DEBUG
 			if (visualize)
@@ -788,6 +812,7 @@ int AAS_ClientMovementPrediction(struct aas_clientmove_s *move,
 					VectorCopy(start, stepend);
 					start[2] += phys_maxstep;
 					steptrace = AAS_TraceClientBBox(start, stepend, presencetype, entnum);
+					numpredictiontraces++;
 					//
 					if (!steptrace.startsolid)
 					{
@@ -912,6 +937,7 @@ int AAS_ClientMovementPrediction(struct aas_clientmove_s *move,
 		} //end if
 		//
 		onground = AAS_OnGround(org, presencetype, entnum);
+		numpredictiontraces++;
 		//if onground and on the ground for at least one whole frame
 		if (onground)
 		{
@@ -950,6 +976,7 @@ int AAS_ClientMovementPrediction(struct aas_clientmove_s *move,
 			VectorCopy(start, end);
 			end[2] -= 48 + aassettings.phys_maxbarrier;
 			gaptrace = AAS_TraceClientBBox(start, end, PRESENCE_CROUCH, -1);
+			numpredictiontraces++;
 			//if solid is found the bot cannot walk any further and will not fall into a gap
 			if (!gaptrace.startsolid)
 			{
@@ -1003,7 +1030,7 @@ int AAS_PredictClientMovement(struct aas_clientmove_s *move,
 	return AAS_ClientMovementPrediction(move, entnum, origin, presencetype, onground,
 										velocity, cmdmove, cmdframes, maxframes,
 										frametime, stopevent, stopareanum,
-										mins, maxs, visualize);
+										mins, maxs, visualize, NULL);
 } //end of the function AAS_PredictClientMovement
 //===========================================================================
 //
@@ -1022,9 +1049,83 @@ int AAS_ClientMovementHitBBox(struct aas_clientmove_s *move,
 	return AAS_ClientMovementPrediction(move, entnum, origin, presencetype, onground,
 										velocity, cmdmove, cmdframes, maxframes,
 										frametime, SE_HITBOUNDINGBOX, 0,
-										mins, maxs, visualize);
+										mins, maxs, visualize, NULL);
 } //end of the function AAS_ClientMovementHitBBox
 //===========================================================================
+// predicts the candidate movements in order until one of them is
+// accepted, candidates with the same start point as the previous
+// candidate share the tests at the start point
+//
+// Parameter:			move			: movement of the accepted candidate
+//						predictions		: candidate movements
+//						numcandidates	: number of candidate movements
+//						acceptevents	: a candidate stopped by one of these
+//										  events within its maximum number of
+//										  frames is accepted
+//						rejectevents	: a candidate stopped by one of these
+//										  events is never accepted
+// Returns:				index of the accepted candidate or -1
+// Changes Globals:		-
+//===========================================================================
+int AAS_PredictClientMovements(struct aas_clientmove_s *move,
+								aas_predictmove_t *predictions, int numcandidates,
+								int acceptevents, int rejectevents)
+{
+	int i, startswimming;
+	vec3_t mins, maxs;
+	aas_predictmove_t *pm, *prevpm;
+
+	VectorClear(mins);
+	VectorClear(maxs);
+	numpredictionbatches++;
+	startswimming = -1;
+	prevpm = NULL;
+	for (i = 0; i < numcandidates; i++)
+	{
+		pm = &predictions[i];
+		if (prevpm && !VectorCompare(pm->origin, prevpm->origin)) startswimming = -1;
+		prevpm = pm;
+		AAS_ClientMovementPrediction(move, pm->entnum, pm->origin, pm->presencetype, pm->onground,
+										pm->velocity, pm->cmdmove, pm->cmdframes, pm->maxframes,
+										pm->frametime, pm->stopevent, pm->stopareanum,
+										mins, maxs, pm->visualize, &startswimming);
+		//if prediction time wasn't enough to fully predict the movement
+		if (move->frames >= pm->maxframes) continue;
+		if (move->stopevent & rejectevents) continue;
+		if (move->stopevent & acceptevents) return i;
+	} //end for
+	return -1;
+} //end of the function AAS_PredictClientMovements
+//===========================================================================
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+void AAS_MovementPredictionStats(void)
+{
+	float frames;
+
+	frames = predictionstatsframes > 0 ? predictionstatsframes : 1;
+	botimport.Print(PRT_MESSAGE, "movement prediction over %d frames:\n", predictionstatsframes);
+	botimport.Print(PRT_MESSAGE, "%6d predictions (%1.2f per frame)\n", numpredictions, numpredictions / frames);
+	botimport.Print(PRT_MESSAGE, "%6d candidate batches\n", numpredictionbatches);
+	if (numpredictions)
+	{
+		botimport.Print(PRT_MESSAGE, "%6d predicted frames (%1.2f per prediction)\n",
+							numpredictionframes, (float) numpredictionframes / numpredictions);
+		botimport.Print(PRT_MESSAGE, "%6d traces (%1.2f per prediction)\n",
+							numpredictiontraces, (float) numpredictiontraces / numpredictions);
+	} //end if
+	botimport.Print(PRT_MESSAGE, "%6d shared start point tests\n", numsharedstarttests);
+	numpredictions = 0;
+	numpredictionbatches = 0;
+	numpredictionframes = 0;
+	numpredictiontraces = 0;
+	numsharedstarttests = 0;
+	predictionstatsframes = 0;
+} //end of the function AAS_MovementPredictionStats
+//===========================================================================
 //
 // Parameter:			-
 // Returns:				-
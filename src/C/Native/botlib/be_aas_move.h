@@ -31,6 +31,29 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #ifdef AASINTERN
 extern aas_settings_t aassettings;
+extern int predictionstatsframes;
+
+//candidate movement for AAS_PredictClientMovements
+typedef struct aas_predictmove_s
+{
+	int entnum;
+	vec3_t origin;
+	int presencetype;
+	int onground;
+	vec3_t velocity;
+	vec3_t cmdmove;
+	int cmdframes;
+	int maxframes;
+	float frametime;
+	int stopevent;
+	int stopareanum;
+	int visualize;
+} aas_predictmove_t;
+
+//predict candidate movements in order until one is accepted, returns the index or -1
+int AAS_PredictClientMovements(struct aas_clientmove_s *move,
+								aas_predictmove_t *predictions, int numcandidates,
+								int acceptevents, int rejectevents);
 #endif //AASINTERN
 
 //movement prediction
@@ -49,6 +72,8 @@ int AAS_ClientMovementHitBBox(struct aas_clientmove_s *move,
 								int cmdframes,
 								int maxframes, float frametime,
 								vec3_t mins, vec3_t maxs, int visualize);
+//prints and resets the movement prediction statistics
+void AAS_MovementPredictionStats(void);
 //returns true if on the ground at the given origin
 int AAS_OnGround(vec3_t origin, int presencetype, int passent);
 //returns true if swimming at the given origin
@@ -61,6 +61,8 @@ extern botlib_import_t botimport;
 #define INSIDEUNITS_WATERJUMP				15
 //area flag used for weapon jumping
 #define AREA_WEAPONJUMP						8192	//valid area to weapon jump to
+
+#define MAX_WEAPONJUMPCANDIDATES			32		//weapon jumps predicted together
 //number of reachabilities of each type
 int reach_swim;			//swim
 int reach_equalfloor;	//walk on floors with equal height
@@ -101,6 +103,25 @@ aas_lreachability_t *reachabilityheap;	//heap with reachabilities
 aas_lreachability_t *nextreachability;	//next free reachability from the heap
 aas_lreachability_t **areareachability;	//reachability links for every area
 int numlreachabilities;
+//grid with the areas used to find the areas near enough to an area to
+//possibly have a swim, walk, step, barrier, ladder or jump reachability
+#define REACHGRID_CELLSIZE			256
+#define REACHGRID_MAXCELLS			128		//maximum number of cells along an axis
+
+typedef struct aas_reachgrid_s
+{
+	float origin[2];				//lower corner of the grid
+	float cellsize;					//size of a grid cell
+	int size[2];					//number of cells along the x and y axis
+	int *cellfirst;					//first index in areas for every cell
+	int *areas;						//areas in every cell sorted on area number
+	int *areastamp;					//stamp used to collect every area only once
+	int stamp;
+	float reachdist;				//maximum x-y distance between reachable areas
+} aas_reachgrid_t;
+
+aas_reachgrid_t reachgrid;
+int *nearbyareas;						//areas near the area reachability is calculated for
 
 //===========================================================================
 // returns the surface area of the given face
@@ -648,6 +669,181 @@ float AAS_MaxJumpDistance(float phys_jumpvel)
 	return phys_maxvelocity * (t + phys_jumpvel / phys_gravity);
 } //end of the function AAS_MaxJumpDistance
 //===========================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+void AAS_ReachabilityGridCells(float *mins, float *maxs, float expand, int *cellmins, int *cellmaxs)
+{
+	int i;
+
+	for (i = 0; i < 2; i++)
+	{
+		cellmins[i] = (int) ((mins[i] - expand - reachgrid.origin[i]) / reachgrid.cellsize);
+		cellmaxs[i] = (int) ((maxs[i] + expand - reachgrid.origin[i]) / reachgrid.cellsize);
+		if (cellmins[i] < 0) cellmins[i] = 0;
+		if (cellmaxs[i] < 0) cellmaxs[i] = 0;
+		if (cellmins[i] >= reachgrid.size[i]) cellmins[i] = reachgrid.size[i] - 1;
+		if (cellmaxs[i] >= reachgrid.size[i]) cellmaxs[i] = reachgrid.size[i] - 1;
+	} //end for
+} //end of the function AAS_ReachabilityGridCells
+//===========================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		reachgrid
+//===========================================================================
+void AAS_ShutDownReachabilityGrid(void)
+{
+	if (reachgrid.cellfirst) FreeMemory(reachgrid.cellfirst);
+	if (reachgrid.areas) FreeMemory(reachgrid.areas);
+	if (reachgrid.areastamp) FreeMemory(reachgrid.areastamp);
+	Com_Memset(&reachgrid, 0, sizeof(aas_reachgrid_t));
+} //end of the function AAS_ShutDownReachabilityGrid
+//===========================================================================
+// sorts all areas into a grid in the x-y plane so the reachability
+// calculation only has to test the areas near enough to each other
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		reachgrid
+//===========================================================================
+void AAS_SetupReachabilityGrid(void)
+{
+	int i, j, x, y, cell, numcells, cellmins[2], cellmaxs[2];
+	float mins[2], maxs[2], extent;
+	aas_area_t *area;
+
+	AAS_ShutDownReachabilityGrid();
+	//maximum x-y distance between two areas with a swim, equal floor height,
+	//step, barrier, waterjump, walk off ledge, ladder or jump reachability
+	reachgrid.reachdist = 2 * AAS_MaxJumpDistance(aassettings.phys_jumpvel) + 10;
+	//
+	mins[0] = mins[1] = 999999;
+	maxs[0] = maxs[1] = -999999;
+	for (i = 1; i < aasworld.numareas; i++)
+	{
+		area = &aasworld.areas[i];
+		for (j = 0; j < 2; j++)
+		{
+			if (area->mins[j] < mins[j]) mins[j] = area->mins[j];
+			if (area->maxs[j] > maxs[j]) maxs[j] = area->maxs[j];
+		} //end for
+	} //end for
+	if (mins[0] > maxs[0]) mins[0] = mins[1] = maxs[0] = maxs[1] = 0;
+	//
+	reachgrid.cellsize = REACHGRID_CELLSIZE;
+	for (j = 0; j < 2; j++)
+	{
+		extent = maxs[j] - mins[j];
+		if (extent / reachgrid.cellsize > REACHGRID_MAXCELLS - 1)
+			reachgrid.cellsize = extent / (REACHGRID_MAXCELLS - 1);
+	} //end for
+	for (j = 0; j < 2; j++)
+	{
+		reachgrid.origin[j] = mins[j];
+		reachgrid.size[j] = (int) ((maxs[j] - mins[j]) / reachgrid.cellsize) + 1;
+		if (reachgrid.size[j] > REACHGRID_MAXCELLS) reachgrid.size[j] = REACHGRID_MAXCELLS;
+	} //end for
+	numcells = reachgrid.size[0] * reachgrid.size[1];
+	reachgrid.cellfirst = (int *) GetClearedMemory((numcells + 1) * sizeof(int));
+	//count the number of areas in every cell
+	for (i = 1; i < aasworld.numareas; i++)
+	{
+		area = &aasworld.areas[i];
+		AAS_ReachabilityGridCells(area->mins, area->maxs, 0, cellmins, cellmaxs);
+		for (x = cellmins[0]; x <= cellmaxs[0]; x++)
+		{
+			for (y = cellmins[1]; y <= cellmaxs[1]; y++)
+			{
+				reachgrid.cellfirst[y * reachgrid.size[0] + x + 1]++;
+			} //end for
+		} //end for
+	} //end for
+	for (cell = 0; cell < numcells; cell++)
+	{
+		reachgrid.cellfirst[cell + 1] += reachgrid.cellfirst[cell];
+	} //end for
+	reachgrid.areas = (int *) GetClearedMemory((reachgrid.cellfirst[numcells] + 1) * sizeof(int));
+	//fill the cells, the areas are added in order so every cell stays sorted
+	for (i = 1; i < aasworld.numareas; i++)
+	{
+		area = &aasworld.areas[i];
+		AAS_ReachabilityGridCells(area->mins, area->maxs, 0, cellmins, cellmaxs);
+		for (x = cellmins[0]; x <= cellmaxs[0]; x++)
+		{
+			for (y = cellmins[1]; y <= cellmaxs[1]; y++)
+			{
+				cell = y * reachgrid.size[0] + x;
+				reachgrid.areas[reachgrid.cellfirst[cell]++] = i;
+			} //end for
+		} //end for
+	} //end for
+	//the fill moved every cell start to the start of the next cell
+	for (cell = numcells; cell > 0; cell--)
+	{
+		reachgrid.cellfirst[cell] = reachgrid.cellfirst[cell - 1];
+	} //end for
+	reachgrid.cellfirst[0] = 0;
+	//
+	reachgrid.areastamp = (int *) GetClearedMemory(aasworld.numareas * sizeof(int));
+	reachgrid.stamp = 0;
+} //end of the function AAS_SetupReachabilityGrid
+//===========================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+int AAS_CompareAreaNums(const void *arg1, const void *arg2)
+{
+	return *(const int *) arg1 - *(const int *) arg2;
+} //end of the function AAS_CompareAreaNums
+//===========================================================================
+// stores all the areas near enough to the given area to possibly have a
+// local reachability from it, the areas are sorted on area number so
+// the reachabilities are created in the same order as when all areas
+// would be tested
+//
+// Parameter:				areanum	: area to find the nearby areas for
+//								areas		: buffer with room for aasworld.numareas areas
+// Returns:					number of areas stored
+// Changes Globals:		reachgrid
+//===========================================================================
+int AAS_NearbyReachabilityAreas(int areanum, int *areas)
+{
+	int i, x, y, cell, otherareanum, numareas, cellmins[2], cellmaxs[2];
+	aas_area_t *area, *otherarea;
+
+	area = &aasworld.areas[areanum];
+	reachgrid.stamp++;
+	numareas = 0;
+	AAS_ReachabilityGridCells(area->mins, area->maxs, reachgrid.reachdist, cellmins, cellmaxs);
+	for (x = cellmins[0]; x <= cellmaxs[0]; x++)
+	{
+		for (y = cellmins[1]; y <= cellmaxs[1]; y++)
+		{
+			cell = y * reachgrid.size[0] + x;
+			for (i = reachgrid.cellfirst[cell]; i < reachgrid.cellfirst[cell + 1]; i++)
+			{
+				otherareanum = reachgrid.areas[i];
+				if (reachgrid.areastamp[otherareanum] == reachgrid.stamp) continue;
+				reachgrid.areastamp[otherareanum] = reachgrid.stamp;
+				//
+				otherarea = &aasworld.areas[otherareanum];
+				if (area->mins[0] > otherarea->maxs[0] + reachgrid.reachdist) continue;
+				if (area->maxs[0] < otherarea->mins[0] - reachgrid.reachdist) continue;
+				if (area->mins[1] > otherarea->maxs[1] + reachgrid.reachdist) continue;
+				if (area->maxs[1] < otherarea->mins[1] - reachgrid.reachdist) continue;
+				areas[numareas++] = otherareanum;
+			} //end for
+		} //end for
+	} //end for
+	qsort(areas, numareas, sizeof(int), AAS_CompareAreaNums);
+	return numareas;
+} //end of the function AAS_NearbyReachabilityAreas
+//===========================================================================
 // returns true if a player can only crouch in the area
 //
 // Parameter:				-
@@ -3993,6 +4189,52 @@ void AAS_SetWeaponJumpAreaFlags(void)
 	botimport.Print(PRT_MESSAGE, "%d weapon jump areas\n", weaponjumpareas);
 } //end of the function AAS_SetWeaponJumpAreaFlags
 //===========================================================================
+// predicts the weapon jump candidates towards the ground faces of area2 and
+// creates a reachability for the first one that gets into area2
+//
+// Parameter:				-
+// Returns:					1 if a reachability was created, -1 if out of
+//								reachabilities, 0 otherwise
+// Changes Globals:		-
+//===========================================================================
+int AAS_WeaponJumpCandidates(int area1num, int area2num, int n, vec3_t areastart,
+								aas_predictmove_t *candidates, vec3_t *facecenters, int numcandidates)
+{
+	int accepted;
+	aas_clientmove_t move;
+	aas_lreachability_t *lreach;
+
+	//the first candidate that gets into the area without entering slime
+	//or lava and without falling from too high is used
+	accepted = AAS_PredictClientMovements(&move, candidates, numcandidates,
+											SE_HITGROUNDAREA|SE_TOUCHJUMPPAD,
+											SE_ENTERSLIME|SE_ENTERLAVA|SE_HITGROUNDDAMAGE);
+	if (accepted < 0) return 0;
+	//create a rocket or bfg jump reachability from area1 to area2
+	lreach = AAS_AllocReachability();
+	if (!lreach) return -1;
+	lreach->areanum = area2num;
+	lreach->facenum = 0;
+	lreach->edgenum = 0;
+	VectorCopy(areastart, lreach->start);
+	VectorCopy(facecenters[accepted], lreach->end);
+	if (n)
+	{
+		lreach->traveltype = TRAVEL_BFGJUMP;
+		lreach->traveltime = aassettings.rs_bfgjump;
+	} //end if
+	else
+	{
+		lreach->traveltype = TRAVEL_ROCKETJUMP;
+		lreach->traveltime = aassettings.rs_rocketjump;
+	} //end else
+	lreach->next = areareachability[area1num];
+	areareachability[area1num] = lreach;
+	//
+	reach_rocketjump++;
+	return 1;
+} //end of the function AAS_WeaponJumpCandidates
+//===========================================================================
 // create a possible weapon jump reachability from area1 to area2
 //
 // check if there's a cool item in the second area
@@ -4005,14 +4247,13 @@ void AAS_SetWeaponJumpAreaFlags(void)
 //===========================================================================
 int AAS_Reachability_WeaponJump(int area1num, int area2num)
 {
-	int face2num, i, n, ret, visualize;
+	int face2num, i, n, ret, visualize, numcandidates, havezvel;
 	float speed, zvel, hordist;
 	aas_face_t *face2;
 	aas_area_t *area1, *area2;
-	aas_lreachability_t *lreach;
-	vec3_t areastart, facecenter, start, end, dir, cmdmove;// teststart;
-	vec3_t velocity;
-	aas_clientmove_t move;
+	vec3_t areastart, start, end, dir;// teststart;
+	vec3_t facecenters[MAX_WEAPONJUMPCANDIDATES];
+	aas_predictmove_t candidates[MAX_WEAPONJUMPCANDIDATES], *pm;
 	aas_trace_t trace;
 
 	visualize = qfalse;
@@ -4042,81 +4283,81 @@ int AAS_Reachability_WeaponJump(int area1num, int area2num)
 	//
 	//areastart is now the start point
 	//
-	for (i = 0; i < area2->numfaces; i++)
+	//NOTE: set to 2 to allow bfg jump reachabilities
+	for (n = 0; n < 1/*2*/; n++)
 	{
-		face2num = aasworld.faceindex[area2->firstface + i];
-		face2 = &aasworld.faces[abs(face2num)];
-		//if it is not a solid face
-		if (!(face2->faceflags & FACE_GROUND)) continue;
-		//get the center of the face
-		AAS_FaceCenter(face2num, facecenter);
-		//only go higher up with weapon jumps
-		if (facecenter[2] < areastart[2] + 64) continue;
-		//NOTE: set to 2 to allow bfg jump reachabilities
-		for (n = 0; n < 1/*2*/; n++)
+		havezvel = qfalse;
+		zvel = 0;
+		numcandidates = 0;
+		for (i = 0; i < area2->numfaces; i++)
 		{
-			//get the rocket jump z velocity
-			if (n) zvel = AAS_BFGJumpZVelocity(areastart);
-			else zvel = AAS_RocketJumpZVelocity(areastart);
+			face2num = aasworld.faceindex[area2->firstface + i];
+			face2 = &aasworld.faces[abs(face2num)];
+			//if it is not a solid face
+			if (!(face2->faceflags & FACE_GROUND)) continue;
+			//get the center of the face
+			AAS_FaceCenter(face2num, facecenters[numcandidates]);
+			//only go higher up with weapon jumps
+			if (facecenters[numcandidates][2] < areastart[2] + 64) continue;
+			//get the rocket jump z velocity, it only depends on the start point
+			if (!havezvel)
+			{
+				if (n) zvel = AAS_BFGJumpZVelocity(areastart);
+				else zvel = AAS_RocketJumpZVelocity(areastart);
+				havezvel = qtrue;
+			} //end if
 			//get the horizontal speed for the jump, if it isn't possible to calculate this
 			//speed (the jump is not possible) then there's no jump reachability created
-			ret = AAS_HorizontalVelocityForJump(zvel, areastart, facecenter, &speed);
+			ret = AAS_HorizontalVelocityForJump(zvel, areastart, facecenters[numcandidates], &speed);
 			if (ret && speed < 300)
 			{
 				//direction towards the face center
-				VectorSubtract(facecenter, areastart, dir);
+				VectorSubtract(facecenters[numcandidates], areastart, dir);
 				dir[2] = 0;
 				hordist = VectorNormalize(dir);
 				//if (hordist < 1.6 * (facecenter[2] - areastart[2]))
 				{
+					pm = &candidates[numcandidates];
+					pm->entnum = -1;
+					VectorCopy(areastart, pm->origin);
+					pm->presencetype = PRESENCE_NORMAL;
+					pm->onground = qtrue;
 					//get command movement
-					VectorScale(dir, speed, cmdmove);
-					VectorSet(velocity, 0, 0, zvel);
+					VectorScale(dir, speed, pm->cmdmove);
+					VectorSet(pm->velocity, 0, 0, zvel);
 					/*
 					//get command movement
 					VectorScale(dir, speed, velocity);
 					velocity[2] = zvel;
 					VectorSet(cmdmove, 0, 0, 0);
 					*/
-					//
-					AAS_PredictClientMovement(&move, -1, areastart, PRESENCE_NORMAL, qtrue,
-												velocity, cmdmove, 30, 30, 0.1f,
-												SE_ENTERWATER|SE_ENTERSLIME|
-												SE_ENTERLAVA|SE_HITGROUNDDAMAGE|
-												SE_TOUCHJUMPPAD|SE_HITGROUND|SE_HITGROUNDAREA, area2num, visualize);
-					//if prediction time wasn't enough to fully predict the movement
-					//don't enter slime or lava and don't fall from too high
-					if (move.frames < 30 && 
-							!(move.stopevent & (SE_ENTERSLIME|SE_ENTERLAVA|SE_HITGROUNDDAMAGE))
-								&& (move.stopevent & (SE_HITGROUNDAREA|SE_TOUCHJUMPPAD)))
-					{
-						//create a rocket or bfg jump reachability from area1 to area2
-						lreach = AAS_AllocReachability();
-						if (!lreach) return qfalse;
-						lreach->areanum = area2num;
-						lreach->facenum = 0;
-						lreach->edgenum = 0;
-						VectorCopy(areastart, lreach->start);
-						VectorCopy(facecenter, lreach->end);
-						if (n)
-						{
-							lreach->traveltype = TRAVEL_BFGJUMP;
-							lreach->traveltime = aassettings.rs_bfgjump;
-						} //end if
-						else
-						{
-							lreach->traveltype = TRAVEL_ROCKETJUMP;
-							lreach->traveltime = aassettings.rs_rocketjump;
-						} //end else
-						lreach->next = areareachability[area1num];
-						areareachability[area1num] = lreach;
-						//
-						reach_rocketjump++;
-						return qtrue;
-					} //end if
+					pm->cmdframes = 30;
+					pm->maxframes = 30;
+					pm->frametime = 0.1f;
+					pm->stopevent = SE_ENTERWATER|SE_ENTERSLIME|
+									SE_ENTERLAVA|SE_HITGROUNDDAMAGE|
+									SE_TOUCHJUMPPAD|SE_HITGROUND|SE_HITGROUNDAREA;
+					pm->stopareanum = area2num;
+					pm->visualize = visualize;
+					numcandidates++;
+				} //end if
+				//predict the candidates if there's no room for more
+				if (numcandidates >= MAX_WEAPONJUMPCANDIDATES)
+				{
+					ret = AAS_WeaponJumpCandidates(area1num, area2num, n, areastart,
+													candidates, facecenters, numcandidates);
+					if (ret) return ret > 0;
+					numcandidates = 0;
 				} //end if
 			} //end if
 		} //end for
+		//predict the remaining candidates
+		if (numcandidates)
+		{
+			ret = AAS_WeaponJumpCandidates(area1num, area2num, n, areastart,
+											candidates, facecenters, numcandidates);
+			if (ret) return ret > 0;
+		} //end if
 	} //end for
 	//
 	return qfalse;
@@ -4368,7 +4609,7 @@ void AAS_StoreReachability(void)
 //===========================================================================
 int AAS_ContinueInitReachability(float time)
 {
-	int i, j, todo, start_time;
+	int i, j, n, todo, start_time, numnearbyareas;
 	static float framereachability, reachability_delay;
 	static int lastpercentage;
 
@@ -4395,9 +4636,11 @@ int AAS_ContinueInitReachability(float time)
 		{
 			continue;
 		} //end if
-		//loop over the areas
-		for (j = 1; j < aasworld.numareas; j++)
+		//loop over the areas near enough to have any of the reachabilities below
+		numnearbyareas = AAS_NearbyReachabilityAreas(i, nearbyareas);
+		for (n = 0; n < numnearbyareas; n++)
 		{
+			j = nearbyareas[n];
 			if (i == j) continue;
 			//never create reachabilities from teleporter or jumppad areas to regular areas
 			if (aasworld.areasettings[i].contents & (AREACONTENTS_TELEPORTER|AREACONTENTS_JUMPPAD))
@@ -4494,6 +4737,8 @@ int AAS_ContinueInitReachability(float time)
 		AAS_ShutDownReachabilityHeap();
 		//
 		FreeMemory(areareachability);
+		FreeMemory(nearbyareas);
+		AAS_ShutDownReachabilityGrid();
 		//
 		aasworld.numreachabilityareas++;
 		//
@@ -4542,6 +4787,9 @@ void AAS_InitReachability(void)
 	//allocate area reachability link array
 	areareachability = (aas_lreachability_t **) GetClearedMemory(
 									aasworld.numareas * sizeof(aas_lreachability_t *));
+	//setup the grid used to find the areas near each other
+	AAS_SetupReachabilityGrid();
+	nearbyareas = (int *) GetClearedMemory(aasworld.numareas * sizeof(int));
 	//
 	AAS_SetWeaponJumpAreaFlags();
 } //end of the function AAS_InitReachable
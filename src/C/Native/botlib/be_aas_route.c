@@ -79,11 +79,34 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #ifdef ROUTING_DEBUG
 int numareacacheupdates;
 int numportalcacheupdates;
+int numareacacherelaxations;
+int numportalcacherelaxations;
 #endif //ROUTING_DEBUG
 
+void AAS_UpdateAreaRoutingCache(aas_routingcache_t *areacache);
+void AAS_UpdatePortalRoutingCache(aas_routingcache_t *portalcache);
+aas_routingcache_t *AAS_GetAreaRoutingCache(int clusternum, int areanum, int travelflags);
+aas_routingcache_t *AAS_GetPortalRoutingCache(int clusternum, int areanum, int travelflags);
+
 int routingcachesize;
 int max_routingcachesize;
 
+//number of the oldest caches considered for eviction
+#define MAX_EVICTIONCANDIDATES		8
+
+//routing cache statistics
+typedef struct routingcachestats_s
+{
+	int hits;									//cache found
+	int misses;									//cache had to be built
+	int buildcost;								//routing updates spent on building caches
+	int evictions;								//caches freed to make room
+	int rebuilds;								//caches built again after eviction
+	int rebuildcost;							//routing updates spent on rebuilding
+} routingcachestats_t;
+
+routingcachestats_t routingcachestats;
+
 //===========================================================================
 //
 // Parameter:			-
@@ -95,6 +118,8 @@ void AAS_RoutingInfo(void)
 {
 	botimport.Print(PRT_MESSAGE, "%d area cache updates\n", numareacacheupdates);
 	botimport.Print(PRT_MESSAGE, "%d portal cache updates\n", numportalcacheupdates);
+	botimport.Print(PRT_MESSAGE, "%d area cache relaxations\n", numareacacherelaxations);
+	botimport.Print(PRT_MESSAGE, "%d portal cache relaxations\n", numportalcacherelaxations);
 	botimport.Print(PRT_MESSAGE, "%d bytes routing cache\n", routingcachesize);
 } //end of the function AAS_RoutingInfo
 #endif //ROUTING_DEBUG
@@ -694,17 +719,36 @@ int AAS_FreeOldestCache(void)
 //===========================================================================
 int AAS_FreeOldestCache(void)
 {
-	int clusterareanum;
-	aas_routingcache_t *cache;
+	int clusterareanum, numcandidates;
+	float score, bestscore;
+	aas_routingcache_t *cache, *bestcache;
 
+	//of the least recently used caches evict the one that is cheapest
+	//to build again and least often reused
+	bestcache = NULL;
+	bestscore = 0;
+	numcandidates = 0;
 	for (cache = aasworld.oldestcache; cache; cache = cache->time_next) {
 		// never free area cache leading towards a portal
 		if (cache->type == CACHETYPE_AREA && aasworld.areasettings[cache->areanum].cluster < 0) {
 			continue;
 		}
-		break;
+		score = (float) (cache->buildcost + 1) * (cache->hits + 1);
+		if (!bestcache || score < bestscore) {
+			bestcache = cache;
+			bestscore = score;
+		}
+		if (++numcandidates >= MAX_EVICTIONCANDIDATES) {
+			break;
+		}
 	}
+	cache = bestcache;
 	if (cache) {
+		// age the caches that were passed over so old popular caches
+		// can't stay in front of the list forever
+		for (bestcache = aasworld.oldestcache; bestcache && bestcache != cache; bestcache = bestcache->time_next) {
+			bestcache->hits >>= 1;
+		}
 		// unlink the cache
 		if (cache->type == CACHETYPE_AREA) {
 			//number of the area in the cluster
@@ -720,6 +764,10 @@ int AAS_FreeOldestCache(void)
 			else aasworld.portalcache[cache->areanum] = cache->next;
 			if (cache->next) cache->next->prev = cache->prev;
 		}
+		if (aasworld.areacachestats) {
+			aasworld.areacachestats[cache->areanum].evicted |= 1 << cache->type;
+		}
+		routingcachestats.evictions++;
 		AAS_FreeRoutingCache(cache);
 		return qtrue;
 	}
@@ -744,12 +792,116 @@ aas_routingcache_t *AAS_AllocRoutingCache(int numtraveltimes)
 	routingcachesize += size;
 	//
 	cache = (aas_routingcache_t *) GetClearedMemory(size);
-	cache->reachabilities = (unsigned char *) cache + sizeof(aas_routingcache_t)
+	cache->traveltimes = (unsigned short int *) ((unsigned char *) cache + sizeof(aas_routingcache_t));
+	cache->reachabilities = (unsigned char *) cache->traveltimes
 								+ numtraveltimes * sizeof(unsigned short int);
 	cache->size = size;
 	return cache;
 } //end of the function AAS_AllocRoutingCache
 //===========================================================================
+// returns the number of travel times stored in the cache
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+static int AAS_RoutingCacheNumTravelTimes(aas_routingcache_t *cache)
+{
+	if (cache->type == CACHETYPE_PORTAL) return aasworld.numportals;
+	return aasworld.clusters[cache->cluster].numreachabilityareas;
+} //end of the function AAS_RoutingCacheNumTravelTimes
+//===========================================================================
+// keeps track of routing cache that was reused or built
+//
+// Parameter:			cache			: the cache
+//						built			: true if the cache was just built
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+static void AAS_RoutingCacheAccess(aas_routingcache_t *cache, int built)
+{
+	aas_areacachestats_t *stats;
+
+	if (!built)
+	{
+		cache->hits++;
+		routingcachestats.hits++;
+		return;
+	} //end if
+	routingcachestats.misses++;
+	routingcachestats.buildcost += cache->buildcost;
+	if (!aasworld.areacachestats) return;
+	stats = &aasworld.areacachestats[cache->areanum];
+	if (stats->evicted & (1 << cache->type))
+	{
+		stats->evicted &= ~(1 << cache->type);
+		stats->rebuilds++;
+		stats->rebuildcost += cache->buildcost;
+		routingcachestats.rebuilds++;
+		routingcachestats.rebuildcost += cache->buildcost;
+	} //end if
+} //end of the function AAS_RoutingCacheAccess
+//===========================================================================
+// prints routing cache statistics and the goal areas with the most
+// expensive cache rebuilds
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+#define MAX_REBUILDAREAS		10
+
+void AAS_RoutingCacheStats(void)
+{
+	int i, j, n, numareacache, numportalcache, numaccess;
+	int areas[MAX_REBUILDAREAS];
+	aas_routingcache_t *cache;
+	aas_areacachestats_t *stats;
+
+	numareacache = 0;
+	numportalcache = 0;
+	for (cache = aasworld.oldestcache; cache; cache = cache->time_next)
+	{
+		if (cache->type == CACHETYPE_AREA) numareacache++;
+		else numportalcache++;
+	} //end for
+	numaccess = routingcachestats.hits + routingcachestats.misses;
+	botimport.Print(PRT_MESSAGE, "%d area cache, %d portal cache\n", numareacache, numportalcache);
+	if (max_routingcachesize > 0)
+		botimport.Print(PRT_MESSAGE, "%d of %d KB routing cache used\n", routingcachesize >> 10, max_routingcachesize >> 10);
+	else
+		botimport.Print(PRT_MESSAGE, "%d KB routing cache used\n", routingcachesize >> 10);
+	botimport.Print(PRT_MESSAGE, "%d hits, %d misses (%d%% hits)\n", routingcachestats.hits, routingcachestats.misses,
+								numaccess ? routingcachestats.hits * 100 / numaccess : 0);
+	botimport.Print(PRT_MESSAGE, "%d routing updates to build cache\n", routingcachestats.buildcost);
+	botimport.Print(PRT_MESSAGE, "%d evictions, %d rebuilds costing %d routing updates\n",
+								routingcachestats.evictions, routingcachestats.rebuilds, routingcachestats.rebuildcost);
+	if (!aasworld.areacachestats) return;
+	//find the goal areas with the most expensive rebuilds
+	n = 0;
+	for (i = 1; i < aasworld.numareas; i++)
+	{
+		stats = &aasworld.areacachestats[i];
+		if (!stats->rebuilds) continue;
+		for (j = n; j > 0; j--)
+		{
+			if (aasworld.areacachestats[areas[j-1]].rebuildcost >= stats->rebuildcost) break;
+			if (j < MAX_REBUILDAREAS) areas[j] = areas[j-1];
+		} //end for
+		if (j < MAX_REBUILDAREAS)
+		{
+			areas[j] = i;
+			if (n < MAX_REBUILDAREAS) n++;
+		} //end if
+	} //end for
+	for (i = 0; i < n; i++)
+	{
+		stats = &aasworld.areacachestats[areas[i]];
+		botimport.Print(PRT_MESSAGE, "area %5d: %4d rebuilds costing %d routing updates\n",
+								areas[i], stats->rebuilds, stats->rebuildcost);
+	} //end for
+} //end of the function AAS_RoutingCacheStats
+//===========================================================================
 //
 // Parameter:			-
 // Returns:				-
@@ -879,6 +1031,35 @@ void AAS_InitRoutingUpdate(void)
 									(aasworld.numportals+1) * sizeof(aas_routingupdate_t));
 } //end of the function AAS_InitRoutingUpdate
 //===========================================================================
+// creates the area routing cache towards every area within the cluster
+// the caches of different clusters do not depend on each other
+//
+// Parameter:			clusternum		: cluster to create the cache for
+//						travelflags		: travel flags for the cache
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+void AAS_CreateClusterRoutingCache(int clusternum, int travelflags)
+{
+	int i, areacluster;
+	aas_portal_t *portal;
+
+	for (i = 1; i < aasworld.numareas; i++)
+	{
+		if (!AAS_AreaReachability(i)) continue;
+		areacluster = aasworld.areasettings[i].cluster;
+		//cluster portals are part of both clusters they separate
+		if (areacluster < 0)
+		{
+			portal = &aasworld.portals[-areacluster];
+			if (portal->frontcluster != clusternum &&
+					portal->backcluster != clusternum) continue;
+		} //end if
+		else if (areacluster != clusternum) continue;
+		AAS_GetAreaRoutingCache(clusternum, i, travelflags);
+	} //end for
+} //end of the function AAS_CreateClusterRoutingCache
+//===========================================================================
 //
 // Parameter:			-
 // Returns:				-
@@ -886,23 +1067,70 @@ void AAS_InitRoutingUpdate(void)
 //===========================================================================
 void AAS_CreateAllRoutingCache(void)
 {
-	int i, j, t;
+	int i, initialized, portalcluster;
+	aas_portal_t *portal;
 
+	initialized = aasworld.initialized;
 	aasworld.initialized = qtrue;
 	botimport.Print(PRT_MESSAGE, "AAS_CreateAllRoutingCache\n");
+	//the area cache of a cluster only depends on that cluster
+	for (i = 1; i < aasworld.numclusters; i++)
+	{
+		AAS_CreateClusterRoutingCache(i, TFL_DEFAULT);
+	} //end for
+	//portal cache towards every area
 	for (i = 1; i < aasworld.numareas; i++)
 	{
 		if (!AAS_AreaReachability(i)) continue;
-		for (j = 1; j < aasworld.numareas; j++)
+		portalcluster = aasworld.areasettings[i].cluster;
+		//portal goal areas are assumed to be part of the front cluster
+		if (portalcluster < 0)
 		{
-			if (i == j) continue;
-			if (!AAS_AreaReachability(j)) continue;
-			t = AAS_AreaTravelTimeToGoalArea(i, aasworld.areas[i].center, j, TFL_DEFAULT);
-			//Log_Write("traveltime from %d to %d is %d", i, j, t);
-		} //end for
+			portal = &aasworld.portals[-portalcluster];
+			portalcluster = portal->frontcluster;
+		} //end if
+		AAS_GetPortalRoutingCache(portalcluster, i, TFL_DEFAULT);
 	} //end for
-	aasworld.initialized = qfalse;
+	aasworld.initialized = initialized;
 } //end of the function AAS_CreateAllRoutingCache
+#ifdef ROUTING_DEBUG
+//===========================================================================
+// builds all routing cache from scratch and prints the time it took and
+// the number of area and portal relaxations
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+void AAS_RoutingBenchmark(void)
+{
+	int starttime, buildtime;
+
+	if (!aasworld.initialized)
+	{
+		botimport.Print(PRT_ERROR, "AAS_RoutingBenchmark: aas not initialized\n");
+		return;
+	} //end if
+	//start without any routing cache
+	AAS_FreeAllClusterAreaCache();
+	AAS_InitClusterAreaCache();
+	AAS_FreeAllPortalCache();
+	AAS_InitPortalCache();
+	numareacacheupdates = 0;
+	numportalcacheupdates = 0;
+	numareacacherelaxations = 0;
+	numportalcacherelaxations = 0;
+	starttime = Sys_MilliSeconds();
+	AAS_CreateAllRoutingCache();
+	buildtime = Sys_MilliSeconds() - starttime;
+	//
+	botimport.Print(PRT_MESSAGE, "all routing cache built in %d msec\n", buildtime);
+	botimport.Print(PRT_MESSAGE, "%d area cache updates with %d relaxations\n",
+								numareacacheupdates, numareacacherelaxations);
+	botimport.Print(PRT_MESSAGE, "%d portal cache updates with %d relaxations\n",
+								numportalcacheupdates, numportalcacherelaxations);
+} //end of the function AAS_RoutingBenchmark
+#endif //ROUTING_DEBUG
 //===========================================================================
 //
 // Parameter:			-
@@ -911,8 +1139,9 @@ void AAS_CreateAllRoutingCache(void)
 //===========================================================================
 
 //the route cache header
-//this header is followed by numportalcache + numareacache aas_routingcache_t
-//structures that store routing cache
+//the header is followed by numportalcache + numareacache routecacheentry_t
+//structures, the travel times of all the caches and then the reachabilities
+//of all the caches, so a file can be read in one block and used in place
 typedef struct routecacheheader_s
 {
 	int ident;
@@ -923,32 +1152,54 @@ typedef struct routecacheheader_s
 	int clustercrc;
 	int numportalcache;
 	int numareacache;
+	int numtraveltimes;			//total number of travel times in the file
 } routecacheheader_t;
 
+//route cache entry
+typedef struct routecacheentry_s
+{
+	int type;					//portal or area cache
+	int cluster;				//cluster the cache is for
+	int areanum;				//area the cache is created for
+	int travelflags;			//combinations of the travel flags
+	int starttraveltime;		//travel time to start with
+	int firsttraveltime;		//first travel time and reachability of the cache
+} routecacheentry_t;
+
+//state while writing the route cache entries
+typedef struct routecachewrite_s
+{
+	fileHandle_t fp;
+	int firsttraveltime;
+} routecachewrite_t;
+
 #define RCID						(('C'<<24)+('R'<<16)+('E'<<8)+'M')
-#define RCVERSION					2
+#define RCVERSION					3
 
 //void AAS_DecompressVis(byte *in, int numareas, byte *decompressed);
 //int AAS_CompressVis(byte *vis, int numareas, byte *dest);
 
-void AAS_WriteRouteCache(void)
+//===========================================================================
+// calls the callback for every portal cache and then every area cache
+// in the order they are stored in the route cache file
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+static void AAS_ForEachRoutingCache(void (*callback)(aas_routingcache_t *cache, void *data), void *data)
 {
-	int i, j, numportalcache, numareacache, totalsize;
+	int i, j;
 	aas_routingcache_t *cache;
 	aas_cluster_t *cluster;
-	fileHandle_t fp;
-	char filename[MAX_QPATH];
-	routecacheheader_t routecacheheader;
 
-	numportalcache = 0;
 	for (i = 0; i < aasworld.numareas; i++)
 	{
 		for (cache = aasworld.portalcache[i]; cache; cache = cache->next)
 		{
-			numportalcache++;
+			callback(cache, data);
 		} //end for
 	} //end for
-	numareacache = 0;
 	for (i = 0; i < aasworld.numclusters; i++)
 	{
 		cluster = &aasworld.clusters[i];
@@ -956,10 +1207,86 @@ void AAS_WriteRouteCache(void)
 		{
 			for (cache = aasworld.clusterareacache[i][j]; cache; cache = cache->next)
 			{
-				numareacache++;
+				callback(cache, data);
 			} //end for
 		} //end for
 	} //end for
+} //end of the function AAS_ForEachRoutingCache
+//===========================================================================
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+static void AAS_CountRouteCache(aas_routingcache_t *cache, void *data)
+{
+	routecacheheader_t *header = (routecacheheader_t *) data;
+
+	if (cache->type == CACHETYPE_PORTAL) header->numportalcache++;
+	else header->numareacache++;
+	header->numtraveltimes += AAS_RoutingCacheNumTravelTimes(cache);
+} //end of the function AAS_CountRouteCache
+//===========================================================================
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+static void AAS_WriteRouteCacheEntry(aas_routingcache_t *cache, void *data)
+{
+	routecachewrite_t *rcwrite = (routecachewrite_t *) data;
+	routecacheentry_t entry;
+
+	entry.type = LittleLong(cache->type);
+	entry.cluster = LittleLong(cache->cluster);
+	entry.areanum = LittleLong(cache->areanum);
+	entry.travelflags = LittleLong(cache->travelflags);
+	entry.starttraveltime = LittleLong((int) cache->starttraveltime);
+	entry.firsttraveltime = LittleLong(rcwrite->firsttraveltime);
+	botimport.FS_Write(&entry, sizeof(routecacheentry_t), rcwrite->fp);
+	rcwrite->firsttraveltime += AAS_RoutingCacheNumTravelTimes(cache);
+} //end of the function AAS_WriteRouteCacheEntry
+//===========================================================================
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+static void AAS_WriteRouteCacheTravelTimes(aas_routingcache_t *cache, void *data)
+{
+	int i, numtraveltimes;
+	unsigned short int t;
+
+	numtraveltimes = AAS_RoutingCacheNumTravelTimes(cache);
+	for (i = 0; i < numtraveltimes; i++)
+	{
+		t = LittleShort(cache->traveltimes[i]);
+		botimport.FS_Write(&t, sizeof(unsigned short int), *(fileHandle_t *) data);
+	} //end for
+} //end of the function AAS_WriteRouteCacheTravelTimes
+//===========================================================================
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+static void AAS_WriteRouteCacheReachabilities(aas_routingcache_t *cache, void *data)
+{
+	botimport.FS_Write(cache->reachabilities, AAS_RoutingCacheNumTravelTimes(cache), *(fileHandle_t *) data);
+} //end of the function AAS_WriteRouteCacheReachabilities
+//===========================================================================
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+void AAS_WriteRouteCache(void)
+{
+	routecachewrite_t rcwrite;
+	fileHandle_t fp;
+	char filename[MAX_QPATH];
+	routecacheheader_t routecacheheader;
+
 	// open the file for writing
 	Com_sprintf(filename, MAX_QPATH, "maps/%s.rcd", aasworld.mapname);
 	botimport.FS_FOpenFile( filename, &fp, FS_WRITE );
@@ -969,78 +1296,64 @@ void AAS_WriteRouteCache(void)
 		return;
 	} //end if
 	//create the header
-	routecacheheader.ident = RCID;
-	routecacheheader.version = RCVERSION;
-	routecacheheader.numareas = aasworld.numareas;
-	routecacheheader.numclusters = aasworld.numclusters;
-	routecacheheader.areacrc = CRC_ProcessString( (unsigned char *)aasworld.areas, sizeof(aas_area_t) * aasworld.numareas );
-	routecacheheader.clustercrc = CRC_ProcessString( (unsigned char *)aasworld.clusters, sizeof(aas_cluster_t) * aasworld.numclusters );
-	routecacheheader.numportalcache = numportalcache;
-	routecacheheader.numareacache = numareacache;
+	Com_Memset(&routecacheheader, 0, sizeof(routecacheheader_t));
+	AAS_ForEachRoutingCache(AAS_CountRouteCache, &routecacheheader);
+	botimport.Print(PRT_MESSAGE, "%d portal cache, %d area cache, %d travel times\n",
+			routecacheheader.numportalcache, routecacheheader.numareacache, routecacheheader.numtraveltimes);
+	routecacheheader.ident = LittleLong(RCID);
+	routecacheheader.version = LittleLong(RCVERSION);
+	routecacheheader.numareas = LittleLong(aasworld.numareas);
+	routecacheheader.numclusters = LittleLong(aasworld.numclusters);
+	routecacheheader.areacrc = LittleLong(CRC_ProcessString( (unsigned char *)aasworld.areas, sizeof(aas_area_t) * aasworld.numareas ));
+	routecacheheader.clustercrc = LittleLong(CRC_ProcessString( (unsigned char *)aasworld.clusters, sizeof(aas_cluster_t) * aasworld.numclusters ));
+	routecacheheader.numportalcache = LittleLong(routecacheheader.numportalcache);
+	routecacheheader.numareacache = LittleLong(routecacheheader.numareacache);
+	routecacheheader.numtraveltimes = LittleLong(routecacheheader.numtraveltimes);
 	//write the header
 	botimport.FS_Write(&routecacheheader, sizeof(routecacheheader_t), fp);
-	//
-	totalsize = 0;
-	//write all the cache
-	for (i = 0; i < aasworld.numareas; i++)
-	{
-		for (cache = aasworld.portalcache[i]; cache; cache = cache->next)
-		{
-			botimport.FS_Write(cache, cache->size, fp);
-			totalsize += cache->size;
-		} //end for
-	} //end for
-	for (i = 0; i < aasworld.numclusters; i++)
-	{
-		cluster = &aasworld.clusters[i];
-		for (j = 0; j < cluster->numareas; j++)
-		{
-			for (cache = aasworld.clusterareacache[i][j]; cache; cache = cache->next)
-			{
-				botimport.FS_Write(cache, cache->size, fp);
-				totalsize += cache->size;
-			} //end for
-		} //end for
-	} //end for
-	// write the visareas
-	/*
-	for (i = 0; i < aasworld.numareas; i++)
-	{
-		if (!aasworld.areavisibility[i]) {
-			size = 0;
-			botimport.FS_Write(&size, sizeof(int), fp);
-			continue;
-		}
-		AAS_DecompressVis( aasworld.areavisibility[i], aasworld.numareas, aasworld.decompressedvis );
-		size = AAS_CompressVis( aasworld.decompressedvis, aasworld.numareas, aasworld.decompressedvis );
-		botimport.FS_Write(&size, sizeof(int), fp);
-		botimport.FS_Write(aasworld.decompressedvis, size, fp);
-	}
-	*/
+	//write the cache entries, each with the index of its first travel time
+	rcwrite.fp = fp;
+	rcwrite.firsttraveltime = 0;
+	AAS_ForEachRoutingCache(AAS_WriteRouteCacheEntry, &rcwrite);
+	//write the travel times and reachabilities of all the caches, storing
+	//the same kind of data together keeps the file well compressible
+	AAS_ForEachRoutingCache(AAS_WriteRouteCacheTravelTimes, &fp);
+	AAS_ForEachRoutingCache(AAS_WriteRouteCacheReachabilities, &fp);
 	//
 	botimport.FS_FCloseFile(fp);
 	botimport.Print(PRT_MESSAGE, "\nroute cache written to %s\n", filename);
-	botimport.Print(PRT_MESSAGE, "written %d bytes of routing cache\n", totalsize);
 } //end of the function AAS_WriteRouteCache
 //===========================================================================
+// links a cache read from the route cache file
 //
 // Parameter:			-
 // Returns:				-
 // Changes Globals:		-
 //===========================================================================
-aas_routingcache_t *AAS_ReadCache(fileHandle_t fp)
+static void AAS_LinkReadCache(aas_routingcache_t *cache)
 {
-	int size;
-	aas_routingcache_t *cache;
+	int clusterareanum;
 
-	botimport.FS_Read(&size, sizeof(size), fp);
-	cache = (aas_routingcache_t *) GetMemory(size);
-	cache->size = size;
-	botimport.FS_Read((unsigned char *)cache + sizeof(size), size - sizeof(size), fp);
-	cache->reachabilities = (unsigned char *) cache + sizeof(aas_routingcache_t) - sizeof(unsigned short) +
-		(size - sizeof(aas_routingcache_t) + sizeof(unsigned short)) / 3 * 2;
-	return cache;
-} //end of the function AAS_ReadCache
+	if (cache->type == CACHETYPE_PORTAL)
+	{
+		cache->next = aasworld.portalcache[cache->areanum];
+		cache->prev = NULL;
+		if (aasworld.portalcache[cache->areanum])
+			aasworld.portalcache[cache->areanum]->prev = cache;
+		aasworld.portalcache[cache->areanum] = cache;
+	} //end if
+	else
+	{
+		clusterareanum = AAS_ClusterAreaNum(cache->cluster, cache->areanum);
+		cache->next = aasworld.clusterareacache[cache->cluster][clusterareanum];
+		cache->prev = NULL;
+		if (aasworld.clusterareacache[cache->cluster][clusterareanum])
+			aasworld.clusterareacache[cache->cluster][clusterareanum]->prev = cache;
+		aasworld.clusterareacache[cache->cluster][clusterareanum] = cache;
+	} //end else
+	cache->time = AAS_RoutingTime();
+	AAS_LinkCache(cache);
+} //end of the function AAS_LinkReadCache
 //===========================================================================
 //
 // Parameter:			-
@@ -1049,71 +1362,131 @@ aas_routingcache_t *AAS_ReadCache(fileHandle_t fp)
 //===========================================================================
 int AAS_ReadRouteCache(void)
 {
-	int i, clusterareanum;//, size;
+	int i, length, numcache, numtraveltimes, datasize, areacluster;
 	fileHandle_t fp;
 	char filename[MAX_QPATH];
 	routecacheheader_t routecacheheader;
+	routecacheentry_t *entries, *entry;
+	unsigned short int *traveltimes;
+	unsigned char *reachabilities;
 	aas_routingcache_t *cache;
 
 	Com_sprintf(filename, MAX_QPATH, "maps/%s.rcd", aasworld.mapname);
-	botimport.FS_FOpenFile( filename, &fp, FS_READ );
+	length = botimport.FS_FOpenFile( filename, &fp, FS_READ );
 	if (!fp)
 	{
 		return qfalse;
 	} //end if
-	botimport.FS_Read(&routecacheheader, sizeof(routecacheheader_t), fp );
-	if (routecacheheader.ident != RCID)
+	if (length < (int) sizeof(routecacheheader_t))
 	{
-		AAS_Error("%s is not a route cache dump\n");
+		botimport.FS_FCloseFile(fp);
+		botimport.Print(PRT_WARNING, "%s is truncated\n", filename);
 		return qfalse;
 	} //end if
-	if (routecacheheader.version != RCVERSION)
+	botimport.FS_Read(&routecacheheader, sizeof(routecacheheader_t), fp );
+	for (i = 0; i < sizeof(routecacheheader_t) / sizeof(int); i++)
 	{
-		AAS_Error("route cache dump has wrong version %d, should be %d", routecacheheader.version, RCVERSION);
+		((int *)&routecacheheader)[i] = LittleLong(((int *)&routecacheheader)[i]);
+	} //end for
+	if (routecacheheader.ident != RCID)
+	{
+		botimport.FS_FCloseFile(fp);
+		AAS_Error("%s is not a route cache dump\n", filename);
 		return qfalse;
 	} //end if
-	if (routecacheheader.numareas != aasworld.numareas)
+	if (routecacheheader.version != RCVERSION)
 	{
-		//AAS_Error("route cache dump has wrong number of areas\n");
+		botimport.FS_FCloseFile(fp);
+		botimport.Print(PRT_WARNING, "%s has wrong version %d, should be %d\n", filename, routecacheheader.version, RCVERSION);
 		return qfalse;
 	} //end if
-	if (routecacheheader.numclusters != aasworld.numclusters)
-	{
-		//AAS_Error("route cache dump has wrong number of clusters\n");
+	if (routecacheheader.numareas != aasworld.numareas ||
+		routecacheheader.numclusters != aasworld.numclusters ||
+		routecacheheader.areacrc !=
+			CRC_ProcessString( (unsigned char *)aasworld.areas, sizeof(aas_area_t) * aasworld.numareas ) ||
+		routecacheheader.clustercrc !=
+			CRC_ProcessString( (unsigned char *)aasworld.clusters, sizeof(aas_cluster_t) * aasworld.numclusters ))
+	{
+		//the route cache dump is for a different AAS file
+		botimport.FS_FCloseFile(fp);
 		return qfalse;
 	} //end if
-	if (routecacheheader.areacrc !=
-		CRC_ProcessString( (unsigned char *)aasworld.areas, sizeof(aas_area_t) * aasworld.numareas ))
-	{
-		//AAS_Error("route cache dump area CRC incorrect\n");
+	numcache = routecacheheader.numportalcache + routecacheheader.numareacache;
+	numtraveltimes = routecacheheader.numtraveltimes;
+	//bound the counts by the file length so the data size can't overflow
+	if (numcache < 0 || numcache > length / (int) sizeof(routecacheentry_t) ||
+		numtraveltimes < 0 || numtraveltimes > length / (int) (sizeof(unsigned short int) + sizeof(unsigned char)))
+	{
+		botimport.FS_FCloseFile(fp);
+		botimport.Print(PRT_WARNING, "%s has invalid counts\n", filename);
 		return qfalse;
 	} //end if
-	if (routecacheheader.clustercrc !=
-		CRC_ProcessString( (unsigned char *)aasworld.clusters, sizeof(aas_cluster_t) * aasworld.numclusters ))
+	datasize = numcache * sizeof(routecacheentry_t) +
+				numtraveltimes * (sizeof(unsigned short int) + sizeof(unsigned char));
+	if ((int) sizeof(routecacheheader_t) + datasize != length)
 	{
-		//AAS_Error("route cache dump cluster CRC incorrect\n");
+		botimport.FS_FCloseFile(fp);
+		botimport.Print(PRT_WARNING, "%s has wrong size %d, should be %d\n", filename,
+							length, (int) sizeof(routecacheheader_t) + datasize);
 		return qfalse;
 	} //end if
-	//read all the portal cache
-	for (i = 0; i < routecacheheader.numportalcache; i++)
+	//read everything after the header at once, the travel times and
+	//reachabilities are used in place
+	aasworld.routecachedata = GetMemory(datasize);
+	routingcachesize += datasize;
+	botimport.FS_Read(aasworld.routecachedata, datasize, fp);
+	botimport.FS_FCloseFile(fp);
+	//
+	entries = (routecacheentry_t *) aasworld.routecachedata;
+	traveltimes = (unsigned short int *) (entries + numcache);
+	reachabilities = (unsigned char *) (traveltimes + numtraveltimes);
+	for (i = 0; i < numtraveltimes; i++)
 	{
-		cache = AAS_ReadCache(fp);
-		cache->next = aasworld.portalcache[cache->areanum];
-		cache->prev = NULL;
-		if (aasworld.portalcache[cache->areanum])
-			aasworld.portalcache[cache->areanum]->prev = cache;
-		aasworld.portalcache[cache->areanum] = cache;
+		traveltimes[i] = LittleShort(traveltimes[i]);
 	} //end for
-	//read all the cluster area cache
-	for (i = 0; i < routecacheheader.numareacache; i++)
-	{
-		cache = AAS_ReadCache(fp);
-		clusterareanum = AAS_ClusterAreaNum(cache->cluster, cache->areanum);
-		cache->next = aasworld.clusterareacache[cache->cluster][clusterareanum];
-		cache->prev = NULL;
-		if (aasworld.clusterareacache[cache->cluster][clusterareanum])
-			aasworld.clusterareacache[cache->cluster][clusterareanum]->prev = cache;
-		aasworld.clusterareacache[cache->cluster][clusterareanum] = cache;
+	//
+	for (i = 0; i < numcache; i++)
+	{
+		entry = &entries[i];
+		entry->type = LittleLong(entry->type);
+		entry->cluster = LittleLong(entry->cluster);
+		entry->areanum = LittleLong(entry->areanum);
+		entry->travelflags = LittleLong(entry->travelflags);
+		entry->starttraveltime = LittleLong(entry->starttraveltime);
+		entry->firsttraveltime = LittleLong(entry->firsttraveltime);
+		//skip entries that do not match this AAS world
+		if (entry->areanum <= 0 || entry->areanum >= aasworld.numareas) continue;
+		if (entry->cluster <= 0 || entry->cluster >= aasworld.numclusters) continue;
+		if (entry->type == CACHETYPE_AREA)
+		{
+			areacluster = aasworld.areasettings[entry->areanum].cluster;
+			if (areacluster > 0 && areacluster != entry->cluster) continue;
+			if (areacluster < 0 && aasworld.portals[-areacluster].frontcluster != entry->cluster &&
+					aasworld.portals[-areacluster].backcluster != entry->cluster) continue;
+		} //end if
+		else if (entry->type != CACHETYPE_PORTAL) continue;
+		//
+		cache = (aas_routingcache_t *) GetClearedMemory(sizeof(aas_routingcache_t));
+		cache->size = sizeof(aas_routingcache_t);
+		routingcachesize += cache->size;
+		cache->type = entry->type;
+		cache->cluster = entry->cluster;
+		cache->areanum = entry->areanum;
+		VectorCopy(aasworld.areas[cache->areanum].center, cache->origin);
+		cache->starttraveltime = entry->starttraveltime;
+		cache->travelflags = entry->travelflags;
+		if (entry->firsttraveltime < 0 ||
+			entry->firsttraveltime + AAS_RoutingCacheNumTravelTimes(cache) > numtraveltimes)
+		{
+			routingcachesize -= cache->size;
+			FreeMemory(cache);
+			continue;
+		} //end if
+		cache->traveltimes = traveltimes + entry->firsttraveltime;
+		cache->reachabilities = reachabilities + entry->firsttraveltime;
+		//estimate the cost to build the cache again
+		cache->buildcost = AAS_RoutingCacheNumTravelTimes(cache);
+		AAS_LinkReadCache(cache);
 	} //end for
 	// read the visareas
 	/*
@@ -1129,7 +1502,7 @@ int AAS_ReadRouteCache(void)
 	}
 	*/
 	//
-	botimport.FS_FCloseFile(fp);
+	botimport.Print(PRT_MESSAGE, "%d routing caches read from %s\n", numcache, filename);
 	return qtrue;
 } //end of the function AAS_ReadRouteCache
 //===========================================================================
@@ -1235,10 +1608,18 @@ void AAS_InitRouting(void)
 #ifdef ROUTING_DEBUG
 	numareacacheupdates = 0;
 	numportalcacheupdates = 0;
+	numareacacherelaxations = 0;
+	numportalcacherelaxations = 0;
 #endif //ROUTING_DEBUG
 	//
 	routingcachesize = 0;
-	max_routingcachesize = 1024 * (int) LibVarValue("max_routingcache", "4096");
+	//the routing cache size is only capped when max_routingcache is set
+	max_routingcachesize = 1024 * (int) LibVarValue("max_routingcache", "0");
+	//
+	Com_Memset(&routingcachestats, 0, sizeof(routingcachestats_t));
+	if (aasworld.areacachestats) FreeMemory(aasworld.areacachestats);
+	aasworld.areacachestats = (aas_areacachestats_t *) GetClearedMemory(
+									aasworld.numareas * sizeof(aas_areacachestats_t));
 	// read any routing cache if available
 	AAS_ReadRouteCache();
 } //end of the function AAS_InitRouting
@@ -1254,6 +1635,12 @@ void AAS_FreeRoutingCaches(void)
 	AAS_FreeAllClusterAreaCache();
 	// free all the existing portal cache
 	AAS_FreeAllPortalCache();
+	// free the routing cache data read from file
+	if (aasworld.routecachedata) FreeMemory(aasworld.routecachedata);
+	aasworld.routecachedata = NULL;
+	// free the routing cache statistics
+	if (aasworld.areacachestats) FreeMemory(aasworld.areacachestats);
+	aasworld.areacachestats = NULL;
 	// free cached travel times within areas
 	if (aasworld.areatraveltimes) FreeMemory(aasworld.areatraveltimes);
 	aasworld.areatraveltimes = NULL;
@@ -1334,6 +1721,10 @@ void AAS_UpdateAreaRoutingCache(aas_routingcache_t *areacache)
 		updateliststart = curupdate->next;
 		//
 		curupdate->inlist = qfalse;
+		areacache->buildcost++;
+#ifdef ROUTING_DEBUG
+		numareacacherelaxations++;
+#endif //ROUTING_DEBUG
 		//check all reversed reachability links
 		revreach = &aasworld.reversedreachability[curupdate->areanum];
 		//
@@ -1424,15 +1815,17 @@ aas_routingcache_t *AAS_GetAreaRoutingCache(int clusternum, int areanum, int tra
 		cache->next = clustercache;
 		if (clustercache) clustercache->prev = cache;
 		aasworld.clusterareacache[clusternum][clusterareanum] = cache;
+		cache->type = CACHETYPE_AREA;
 		AAS_UpdateAreaRoutingCache(cache);
+		AAS_RoutingCacheAccess(cache, qtrue);
 	} //end if
 	else
 	{
 		AAS_UnlinkCache(cache);
+		AAS_RoutingCacheAccess(cache, qfalse);
 	} //end else
 	//the cache has been accessed
 	cache->time = AAS_RoutingTime();
-	cache->type = CACHETYPE_AREA;
 	AAS_LinkCache(cache);
 	return cache;
 } //end of the function AAS_GetAreaRoutingCache
@@ -1482,6 +1875,10 @@ void AAS_UpdatePortalRoutingCache(aas_routingcache_t *portalcache)
 		updateliststart = curupdate->next;
 		//current update is removed from the list
 		curupdate->inlist = qfalse;
+		portalcache->buildcost++;
+#ifdef ROUTING_DEBUG
+		numportalcacherelaxations++;
+#endif //ROUTING_DEBUG
 		//
 		cluster = &aasworld.clusters[curupdate->cluster];
 		//
@@ -1564,15 +1961,17 @@ aas_routingcache_t *AAS_GetPortalRoutingCache(int clusternum, int areanum, int t
 		if (aasworld.portalcache[areanum]) aasworld.portalcache[areanum]->prev = cache;
 		aasworld.portalcache[areanum] = cache;
 		//update the cache
+		cache->type = CACHETYPE_PORTAL;
 		AAS_UpdatePortalRoutingCache(cache);
+		AAS_RoutingCacheAccess(cache, qtrue);
 	} //end if
 	else
 	{
 		AAS_UnlinkCache(cache);
+		AAS_RoutingCacheAccess(cache, qfalse);
 	} //end else
 	//the cache has been accessed
 	cache->time = AAS_RoutingTime();
-	cache->type = CACHETYPE_PORTAL;
 	AAS_LinkCache(cache);
 	return cache;
 } //end of the function AAS_GetPortalRoutingCache
@@ -1617,7 +2016,8 @@ int AAS_AreaRouteToGoalArea(int areanum, vec3_t origin, int goalareanum, int tra
 		return qfalse;
 	} //end if
 	// make sure the routing cache doesn't grow to large
-	while(AvailableMemory() < 1 * 1024 * 1024) {
+	while((max_routingcachesize > 0 && routingcachesize > max_routingcachesize) ||
+			AvailableMemory() < 1 * 1024 * 1024) {
 		if (!AAS_FreeOldestCache()) break;
 	}
 	//
@@ -2082,21 +2482,30 @@ int AAS_NearestHideArea(int srcnum, vec3_t origin, int areanum, int enemynum, ve
 	int i, j, nextareanum, badtravelflags, numreach, bestarea;
 	unsigned short int t, besttraveltime;
 	static unsigned short int *hidetraveltimes;
+	static int *hidesearchstamps, hidesearchstamp, hidenumareas;
 	aas_routingupdate_t *updateliststart, *updatelistend, *curupdate, *nextupdate;
 	aas_reachability_t *reach;
 	float dist1, dist2;
 	vec3_t v1, v2, p;
 	qboolean startVisible;
 
-	//
-	if (!hidetraveltimes)
+	//the travel times are only valid for areas stamped with the current
+	//search so they don't have to be cleared for every search
+	if (!hidetraveltimes || hidenumareas != aasworld.numareas)
 	{
+		if (hidetraveltimes) FreeMemory(hidetraveltimes);
+		if (hidesearchstamps) FreeMemory(hidesearchstamps);
 		hidetraveltimes = (unsigned short int *) GetClearedMemory(aasworld.numareas * sizeof(unsigned short int));
+		hidesearchstamps = (int *) GetClearedMemory(aasworld.numareas * sizeof(int));
+		hidenumareas = aasworld.numareas;
+		hidesearchstamp = 0;
 	} //end if
-	else
+	hidesearchstamp++;
+	if (hidesearchstamp <= 0)
 	{
-		Com_Memset(hidetraveltimes, 0, aasworld.numareas * sizeof(unsigned short int));
-	} //end else
+		Com_Memset(hidesearchstamps, 0, aasworld.numareas * sizeof(int));
+		hidesearchstamp = 1;
+	} //end if
 	besttraveltime = 0;
 	bestarea = 0;
 	//assume visible
@@ -2176,7 +2585,8 @@ int AAS_NearestHideArea(int srcnum, vec3_t origin, int areanum, int enemynum, ve
 			//
 			if (besttraveltime && t >= besttraveltime) continue;
 			//
-			if (!hidetraveltimes[nextareanum] ||
+			if (hidesearchstamps[nextareanum] != hidesearchstamp ||
+					!hidetraveltimes[nextareanum] ||
 					hidetraveltimes[nextareanum] > t)
 			{
 				//if the nextarea is not visible from the enemy area
@@ -2186,6 +2596,7 @@ int AAS_NearestHideArea(int srcnum, vec3_t origin, int areanum, int enemynum, ve
 					bestarea = nextareanum;
 				} //end if
 				hidetraveltimes[nextareanum] = t;
+				hidesearchstamps[nextareanum] = hidesearchstamp;
 				nextupdate = &aasworld.areaupdate[nextareanum];
 				nextupdate->areanum = nextareanum;
 				nextupdate->tmptraveltime = t;
@@ -37,10 +37,15 @@ void AAS_FreeRoutingCaches(void);
 //returns the travel time from start to end in the given area
 unsigned short int AAS_AreaTravelTime(int areanum, vec3_t start, vec3_t end);
 //
+void AAS_CreateClusterRoutingCache(int clusternum, int travelflags);
 void AAS_CreateAllRoutingCache(void);
 void AAS_WriteRouteCache(void);
 //
 void AAS_RoutingInfo(void);
+//build all routing cache and print the build time and relaxation counts
+void AAS_RoutingBenchmark(void);
+//print routing cache statistics
+void AAS_RoutingCacheStats(void);
 #endif //AASINTERN
 
 //returns the travel flag for the given travel type
@@ -48,12 +48,14 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 typedef struct midrangearea_s
 {
-	int valid;
+	int valid;						//valid when equal to midrangestamp
 	unsigned short starttime;
 	unsigned short goaltime;
 } midrangearea_t;
 
 midrangearea_t *midrangeareas;
+int midrangestamp;
+int *midrangearealist;
 int *clusterareas;
 int numclusterareas;
 
@@ -85,7 +87,7 @@ void AAS_AltRoutingFloodCluster_r(int areanum)
 		//if there is an area at the other side of this face
 		if (!otherareanum) continue;
 		//if the other area is not a midrange area
-		if (!midrangeareas[otherareanum].valid) continue;
+		if (midrangeareas[otherareanum].valid != midrangestamp) continue;
 		//
 		AAS_AltRoutingFloodCluster_r(otherareanum);
 	} //end for
@@ -103,7 +105,7 @@ int AAS_AlternativeRouteGoals(vec3_t start, int startareanum, vec3_t goal, int g
 #ifndef ENABLE_ALTROUTING
 	return 0;
 #else
-	int i, j, bestareanum;
+	int i, j, k, bestareanum;
 	int numaltroutegoals, nummidrangeareas;
 	int starttime, goaltime, goaltraveltime;
 	float dist, bestdist;
@@ -118,8 +120,13 @@ int AAS_AlternativeRouteGoals(vec3_t start, int startareanum, vec3_t goal, int g
 		return 0;
 	//travel time towards the goal area
 	goaltraveltime = AAS_AreaTravelTimeToGoalArea(startareanum, start, goalareanum, travelflags);
-	//clear the midrange areas
-	Com_Memset(midrangeareas, 0, aasworld.numareas * sizeof(midrangearea_t));
+	//invalidate the midrange areas of the previous call
+	midrangestamp++;
+	if (midrangestamp <= 0)
+	{
+		Com_Memset(midrangeareas, 0, aasworld.numareas * sizeof(midrangearea_t));
+		midrangestamp = 1;
+	} //end if
 	numaltroutegoals = 0;
 	//
 	nummidrangeareas = 0;
@@ -150,16 +157,17 @@ int AAS_AlternativeRouteGoals(vec3_t start, int startareanum, vec3_t goal, int g
 		//if the travel time from the area to the goal is greater than the shortest goal travel time
 		if (goaltime > (float) 0.8 * goaltraveltime) continue;
 		//this is a mid range area
-		midrangeareas[i].valid = qtrue;
+		midrangeareas[i].valid = midrangestamp;
 		midrangeareas[i].starttime = starttime;
 		midrangeareas[i].goaltime = goaltime;
 		Log_Write("%d midrange area %d", nummidrangeareas, i);
-		nummidrangeareas++;
+		midrangearealist[nummidrangeareas++] = i;
 	} //end for
-	//
-	for (i = 1; i < aasworld.numareas; i++)
+	//only the midrange areas found above have to be checked
+	for (k = 0; k < nummidrangeareas; k++)
 	{
-		if (!midrangeareas[i].valid) continue;
+		i = midrangearealist[k];
+		if (midrangeareas[i].valid != midrangestamp) continue;
 		//get the areas in one cluster
 		numclusterareas = 0;
 		AAS_AltRoutingFloodCluster_r(i);
@@ -217,7 +225,10 @@ void AAS_InitAlternativeRouting(void)
 {
 #ifdef ENABLE_ALTROUTING
 	if (midrangeareas) FreeMemory(midrangeareas);
-	midrangeareas = (midrangearea_t *) GetMemory(aasworld.numareas * sizeof(midrangearea_t));
+	midrangeareas = (midrangearea_t *) GetClearedMemory(aasworld.numareas * sizeof(midrangearea_t));
+	midrangestamp = 0;
+	if (midrangearealist) FreeMemory(midrangearealist);
+	midrangearealist = (int *) GetMemory(aasworld.numareas * sizeof(int));
 	if (clusterareas) FreeMemory(clusterareas);
 	clusterareas = (int *) GetMemory(aasworld.numareas * sizeof(int));
 #endif
@@ -233,6 +244,8 @@ void AAS_ShutdownAlternativeRouting(void)
 #ifdef ENABLE_ALTROUTING
 	if (midrangeareas) FreeMemory(midrangeareas);
 	midrangeareas = NULL;
+	if (midrangearealist) FreeMemory(midrangearealist);
+	midrangearealist = NULL;
 	if (clusterareas) FreeMemory(clusterareas);
 	clusterareas = NULL;
 	numclusterareas = 0;
@@ -204,6 +204,100 @@ void AAS_FreeAASLinkedEntities(void)
 	aasworld.arealinkedentities = NULL;
 } //end of the function AAS_InitAASLinkedEntities
 //===========================================================================
+// copies every node of the AAS bsp tree together with its plane into one
+// array so a tree walk only touches a single cache line per node
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		aasworld.packednodes, aasworld.pointareacache
+//===========================================================================
+void AAS_InitPackedNodes(void)
+{
+	int i;
+	aas_node_t *node;
+
+	AAS_FreePackedNodes();
+	if (aasworld.numnodes <= 0) return;
+	aasworld.packednodes = (aas_packednode_t *) GetHunkMemory(aasworld.numnodes * sizeof(aas_packednode_t));
+	for (i = 0; i < aasworld.numnodes; i++)
+	{
+		node = &aasworld.nodes[i];
+		aasworld.packednodes[i].node = *node;
+		//node zero is a dummy and may not have a valid plane
+		if (node->planenum >= 0 && node->planenum < aasworld.numplanes)
+		{
+			aasworld.packednodes[i].plane = aasworld.planes[node->planenum];
+		} //end if
+		else
+		{
+			Com_Memset(&aasworld.packednodes[i].plane, 0, sizeof(aas_plane_t));
+		} //end else
+	} //end for
+	//the point to area mapping never changes for a loaded map so the
+	//cache only has to be cleared when the tree is rebuilt
+	aasworld.pointareacache = (aas_pointareacache_t *) GetHunkMemory(POINTAREACACHE_SIZE * sizeof(aas_pointareacache_t));
+	for (i = 0; i < POINTAREACACHE_SIZE; i++)
+	{
+		aasworld.pointareacache[i].areanum = -1;
+	} //end for
+} //end of the function AAS_InitPackedNodes
+//===========================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		aasworld.packednodes, aasworld.pointareacache
+//===========================================================================
+void AAS_FreePackedNodes(void)
+{
+	if (aasworld.packednodes) FreeMemory(aasworld.packednodes);
+	aasworld.packednodes = NULL;
+	if (aasworld.pointareacache) FreeMemory(aasworld.pointareacache);
+	aasworld.pointareacache = NULL;
+} //end of the function AAS_FreePackedNodes
+//===========================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+static int AAS_PointAreaCacheSlot(vec3_t point)
+{
+	unsigned int hash, bits;
+	int i;
+
+	hash = 0;
+	for (i = 0; i < 3; i++)
+	{
+		Com_Memcpy(&bits, &point[i], sizeof(bits));
+		hash = (hash ^ bits) * 16777619u;
+	} //end for
+	return (hash ^ (hash >> 15)) & (POINTAREACACHE_SIZE - 1);
+} //end of the function AAS_PointAreaCacheSlot
+//===========================================================================
+// walks the packed bsp tree, the plane tests are the same as the ones
+// done by the unpacked walk so the results are identical
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+static int AAS_PackedPointAreaNum(vec3_t point)
+{
+	int nodenum;
+	vec_t dist;
+	aas_packednode_t *packed;
+
+	nodenum = 1;
+	while (nodenum > 0)
+	{
+		packed = &aasworld.packednodes[nodenum];
+		dist = DotProduct(point, packed->plane.normal) - packed->plane.dist;
+		if (dist > 0) nodenum = packed->node.children[0];
+		else nodenum = packed->node.children[1];
+	} //end while
+	return -nodenum;
+} //end of the function AAS_PackedPointAreaNum
+//===========================================================================
 // returns the AAS area the point is in
 //
 // Parameter:				-
@@ -223,6 +317,20 @@ int AAS_PointAreaNum(vec3_t point)
 		return 0;
 	} //end if
 
+	if (aasworld.packednodes)
+	{
+		aas_pointareacache_t *cache;
+
+		cache = &aasworld.pointareacache[AAS_PointAreaCacheSlot(point)];
+		//compare the bits so the cached result is exactly what a walk would return
+		if (cache->areanum < 0 || memcmp(cache->point, point, sizeof(vec3_t)))
+		{
+			Com_Memcpy(cache->point, point, sizeof(vec3_t));
+			cache->areanum = AAS_PackedPointAreaNum(point);
+		} //end if
+		return cache->areanum;
+	} //end if
+
 	//start with node 1 because node zero is a dummy used for solid leafs
 	nodenum = 1;
 	while (nodenum > 0)
@@ -597,14 +705,21 @@ aas_trace_t AAS_TraceClientBBox(vec3_t start, vec3_t end, int presencetype,
 			return trace;
 		} //end if
 #endif //AAS_SAMPLE_DEBUG
-		//the node to test against
-		aasnode = &aasworld.nodes[nodenum];
+		//the node to test against and the current node plane
+		if (aasworld.packednodes)
+		{
+			aasnode = &aasworld.packednodes[nodenum].node;
+			plane = &aasworld.packednodes[nodenum].plane;
+		} //end if
+		else
+		{
+			aasnode = &aasworld.nodes[nodenum];
+			plane = &aasworld.planes[aasnode->planenum];
+		} //end else
 		//start point of current line to test against node
 		VectorCopy(tstack_p->start, cur_start);
 		//end point of the current line to test against node
 		VectorCopy(tstack_p->end, cur_end);
-		//the current node plane
-		plane = &aasworld.planes[aasnode->planenum];
 
 		switch(plane->type)
 		{/*FIXME: wtf doesn't this work? obviously the axial node planes aren't always facing positive!!!
@@ -788,14 +903,21 @@ int AAS_TraceAreas(vec3_t start, vec3_t end, int *areas, vec3_t *points, int max
 			return numareas;
 		} //end if
 #endif //AAS_SAMPLE_DEBUG
-		//the node to test against
-		aasnode = &aasworld.nodes[nodenum];
+		//the node to test against and the current node plane
+		if (aasworld.packednodes)
+		{
+			aasnode = &aasworld.packednodes[nodenum].node;
+			plane = &aasworld.packednodes[nodenum].plane;
+		} //end if
+		else
+		{
+			aasnode = &aasworld.nodes[nodenum];
+			plane = &aasworld.planes[aasnode->planenum];
+		} //end else
 		//start point of current line to test against node
 		VectorCopy(tstack_p->start, cur_start);
 		//end point of the current line to test against node
 		VectorCopy(tstack_p->end, cur_end);
-		//the current node plane
-		plane = &aasworld.planes[aasnode->planenum];
 
 		switch(plane->type)
 		{/*FIXME: wtf doesn't this work? obviously the node planes aren't always facing positive!!!
@@ -1283,10 +1405,17 @@ aas_link_t *AAS_AASLinkEntity(vec3_t absmins, vec3_t absmaxs, int entnum)
 		} //end if
 		//if solid leaf
 		if (!nodenum) continue;
-		//the node to test against
-		aasnode = &aasworld.nodes[nodenum];
-		//the current node plane
-		plane = &aasworld.planes[aasnode->planenum];
+		//the node to test against and the current node plane
+		if (aasworld.packednodes)
+		{
+			aasnode = &aasworld.packednodes[nodenum].node;
+			plane = &aasworld.packednodes[nodenum].plane;
+		} //end if
+		else
+		{
+			aasnode = &aasworld.nodes[nodenum];
+			plane = &aasworld.planes[aasnode->planenum];
+		} //end else
 		//get the side(s) the box is situated relative to the plane
 		side = AAS_BoxOnPlaneSide2(absmins, absmaxs, plane);
 		//if on the front side of the node
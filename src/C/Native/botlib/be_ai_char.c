@@ -219,7 +219,7 @@ bot_character_t *BotLoadCharacterFromFile(char *charfile, int skill)
 	foundcharacter = qfalse;
 	//a bot character is parsed in two phases
 	PC_SetBaseFolder(BOTFILESBASEFOLDER);
-	source = LoadSourceFile(charfile);
+	source = LoadPrecompiledSourceFile(charfile);
 	if (!source)
 	{
 		botimport.Print(PRT_ERROR, "counldn't load %s\n", charfile);
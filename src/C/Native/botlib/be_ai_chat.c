@@ -111,6 +111,7 @@ typedef struct bot_synonym_s
 {
 	char *string;
 	float weight;
+	int pattern;						//pattern in the synonym automaton
 	struct bot_synonym_s *next;
 } bot_synonym_t;
 //list with synonyms
@@ -126,6 +127,7 @@ typedef struct bot_synonymlist_s
 typedef struct bot_matchstring_s
 {
 	char *string;
+	int pattern;						//pattern in the match automaton
 	struct bot_matchstring_s *next;
 } bot_matchstring_t;
 
@@ -147,6 +149,27 @@ typedef struct bot_matchtemplate_s
 	struct bot_matchtemplate_s *next;
 } bot_matchtemplate_t;
 
+//string matching automaton node
+typedef struct bot_automatonnode_s
+{
+	int character;						//upper case character leading to this node
+	int child;							//first child node
+	int sibling;						//next child node of the parent
+	int fail;							//node of the longest proper suffix
+	int output;							//next node on the fail chain ending a pattern
+	int pattern;						//pattern ending at this node, -1 if none
+} bot_automatonnode_t;
+//string matching automaton, finds all the patterns in a string in one pass
+typedef struct bot_automaton_s
+{
+	bot_automatonnode_t *nodes;
+	int numnodes;
+	int maxnodes;
+	int numpatterns;
+	int *found;							//scan the pattern was last found in
+	int scan;							//number of the last scan
+} bot_automaton_t;
+
 //reply chat key
 typedef struct bot_replychatkey_s
 {
@@ -205,6 +228,9 @@ bot_consolemessage_t *freeconsolemessages = NULL;
 bot_matchtemplate_t *matchtemplates = NULL;
 //list with synonyms
 bot_synonymlist_t *synonyms = NULL;
+//automatons with all the match strings and synonyms
+bot_automaton_t matchautomaton;
+bot_automaton_t synonymautomaton;
 //list with random strings
 bot_randomlist_t *randomstrings = NULL;
 //reply chats
@@ -534,9 +560,197 @@ char *StringContainsWord(char *str1, char *str2, int casesensitive)
 // Returns:					-
 // Changes Globals:		-
 //===========================================================================
-void StringReplaceWords(char *string, char *synonym, char *replacement)
+void BotInitAutomaton(bot_automaton_t *automaton)
+{
+	Com_Memset(automaton, 0, sizeof(bot_automaton_t));
+	automaton->maxnodes = 256;
+	automaton->nodes = (bot_automatonnode_t *) GetClearedMemory(automaton->maxnodes * sizeof(bot_automatonnode_t));
+	//the root node
+	automaton->nodes[0].child = -1;
+	automaton->nodes[0].sibling = -1;
+	automaton->nodes[0].output = -1;
+	automaton->nodes[0].pattern = -1;
+	automaton->numnodes = 1;
+} //end of the function BotInitAutomaton
+//===========================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+void BotFreeAutomaton(bot_automaton_t *automaton)
+{
+	if (automaton->nodes) FreeMemory(automaton->nodes);
+	if (automaton->found) FreeMemory(automaton->found);
+	Com_Memset(automaton, 0, sizeof(bot_automaton_t));
+} //end of the function BotFreeAutomaton
+//===========================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+int BotAutomatonChild(bot_automaton_t *automaton, int node, int c)
+{
+	int child;
+
+	for (child = automaton->nodes[node].child; child >= 0; child = automaton->nodes[child].sibling)
+	{
+		if (automaton->nodes[child].character == c) return child;
+	} //end for
+	return -1;
+} //end of the function BotAutomatonChild
+//===========================================================================
+// adds a case insensitive pattern to the automaton, the same string
+// always gets the same pattern number
+//
+// Parameter:				-
+// Returns:					pattern number or -1 for the empty string
+// Changes Globals:		-
+//===========================================================================
+int BotAutomatonAddPattern(bot_automaton_t *automaton, char *string)
+{
+	int node, child, c;
+	bot_automatonnode_t *newnodes;
+
+	if (!*string) return -1;
+	node = 0;
+	for (; *string; string++)
+	{
+		c = toupper(*string);
+		child = BotAutomatonChild(automaton, node, c);
+		if (child < 0)
+		{
+			if (automaton->numnodes >= automaton->maxnodes)
+			{
+				automaton->maxnodes *= 2;
+				newnodes = (bot_automatonnode_t *) GetClearedMemory(automaton->maxnodes * sizeof(bot_automatonnode_t));
+				Com_Memcpy(newnodes, automaton->nodes, automaton->numnodes * sizeof(bot_automatonnode_t));
+				FreeMemory(automaton->nodes);
+				automaton->nodes = newnodes;
+			} //end if
+			child = automaton->numnodes++;
+			automaton->nodes[child].character = c;
+			automaton->nodes[child].child = -1;
+			automaton->nodes[child].sibling = automaton->nodes[node].child;
+			automaton->nodes[child].output = -1;
+			automaton->nodes[child].pattern = -1;
+			automaton->nodes[node].child = child;
+		} //end if
+		node = child;
+	} //end for
+	if (automaton->nodes[node].pattern < 0)
+	{
+		automaton->nodes[node].pattern = automaton->numpatterns++;
+	} //end if
+	return automaton->nodes[node].pattern;
+} //end of the function BotAutomatonAddPattern
+//===========================================================================
+// calculates the fail links breadth first, after this no patterns can
+// be added
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+void BotFinishAutomaton(bot_automaton_t *automaton)
+{
+	int *queue, queuestart, queueend, node, child, fail, next;
+	bot_automatonnode_t *nodes;
+
+	nodes = automaton->nodes;
+	queue = (int *) GetMemory(automaton->numnodes * sizeof(int));
+	queuestart = queueend = 0;
+	for (child = nodes[0].child; child >= 0; child = nodes[child].sibling)
+	{
+		nodes[child].fail = 0;
+		queue[queueend++] = child;
+	} //end for
+	while(queuestart < queueend)
+	{
+		node = queue[queuestart++];
+		for (child = nodes[node].child; child >= 0; child = nodes[child].sibling)
+		{
+			//the longest proper suffix that is also in the trie
+			fail = nodes[node].fail;
+			next = BotAutomatonChild(automaton, fail, nodes[child].character);
+			while(next < 0 && fail)
+			{
+				fail = nodes[fail].fail;
+				next = BotAutomatonChild(automaton, fail, nodes[child].character);
+			} //end while
+			if (next < 0) next = 0;
+			nodes[child].fail = next;
+			//the next node on the fail chain that ends a pattern
+			if (nodes[next].pattern >= 0) nodes[child].output = next;
+			else nodes[child].output = nodes[next].output;
+			queue[queueend++] = child;
+		} //end for
+	} //end while
+	FreeMemory(queue);
+	//
+	automaton->found = (int *) GetClearedMemory((automaton->numpatterns + 1) * sizeof(int));
+	automaton->scan = 0;
+} //end of the function BotFinishAutomaton
+//===========================================================================
+// marks all patterns that occur in the string in one pass
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+void BotAutomatonScan(bot_automaton_t *automaton, char *string)
+{
+	int node, next, c, n;
+	bot_automatonnode_t *nodes;
+
+	if (!automaton->found) return;
+	automaton->scan++;
+	nodes = automaton->nodes;
+	node = 0;
+	for (; *string; string++)
+	{
+		c = toupper(*string);
+		next = BotAutomatonChild(automaton, node, c);
+		while(next < 0 && node)
+		{
+			node = nodes[node].fail;
+			next = BotAutomatonChild(automaton, node, c);
+		} //end while
+		if (next < 0) next = 0;
+		node = next;
+		//mark all patterns ending here
+		for (n = node; n > 0; n = nodes[n].output)
+		{
+			if (nodes[n].pattern >= 0) automaton->found[nodes[n].pattern] = automaton->scan;
+		} //end for
+	} //end for
+} //end of the function BotAutomatonScan
+//===========================================================================
+// returns false only if the pattern certainly isn't in the last
+// scanned string
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+int BotAutomatonFound(bot_automaton_t *automaton, int pattern)
+{
+	if (pattern < 0 || !automaton->found) return qtrue;
+	return automaton->found[pattern] == automaton->scan;
+} //end of the function BotAutomatonFound
+//===========================================================================
+//
+// Parameter:				-
+// Returns:					true if words were replaced
+// Changes Globals:		-
+//===========================================================================
+int StringReplaceWords(char *string, char *synonym, char *replacement)
 {
 	char *str, *str2;
+	int replaced;
+
+	replaced = qfalse;
 
 	//find the synonym in the string
 	str = StringContainsWord(string, synonym, qfalse);
@@ -556,10 +770,12 @@ void StringReplaceWords(char *string, char *synonym, char *replacement)
 			memmove(str + strlen(replacement), str+strlen(synonym), strlen(str+strlen(synonym))+1);
 			//append the synonum replacement
 			Com_Memcpy(str, replacement, strlen(replacement));
+			replaced = qtrue;
 		} //end if
 		//find the next synonym in the string
 		str = StringContainsWord(str+strlen(replacement), synonym, qfalse);
 	} //end if
+	return replaced;
 } //end of the function StringReplaceWords
 //===========================================================================
 //
@@ -613,7 +829,7 @@ bot_synonymlist_t *BotLoadSynonyms(char *filename)
 		if (pass && size) ptr = (char *) GetClearedHunkMemory(size);
 		//
 		PC_SetBaseFolder(BOTFILESBASEFOLDER);
-		source = LoadSourceFile(filename);
+		source = LoadPrecompiledSourceFile(filename);
 		if (!source)
 		{
 			botimport.Print(PRT_ERROR, "counldn't load %s\n", filename);
@@ -696,6 +912,7 @@ bot_synonymlist_t *BotLoadSynonyms(char *filename)
 							synonym->string = ptr;
 							ptr += strlen(token.string) + 1;
 							strcpy(synonym->string, token.string);
+							synonym->pattern = -1;
 							//
 							if (lastsynonym) lastsynonym->next = synonym;
 							else syn->firstsynonym = synonym;
@@ -763,12 +980,18 @@ void BotReplaceSynonyms(char *string, unsigned long int context)
 	bot_synonymlist_t *syn;
 	bot_synonym_t *synonym;
 
+	//find all the synonyms in the string
+	BotAutomatonScan(&synonymautomaton, string);
 	for (syn = synonyms; syn; syn = syn->next)
 	{
 		if (!(syn->context & context)) continue;
 		for (synonym = syn->firstsynonym->next; synonym; synonym = synonym->next)
 		{
-			StringReplaceWords(string, synonym->string, syn->firstsynonym->string);
+			if (!BotAutomatonFound(&synonymautomaton, synonym->pattern)) continue;
+			if (StringReplaceWords(string, synonym->string, syn->firstsynonym->string))
+			{
+				BotAutomatonScan(&synonymautomaton, string);
+			} //end if
 		} //end for
 	} //end for
 } //end of the function BotReplaceSynonyms
@@ -784,6 +1007,8 @@ void BotReplaceWeightedSynonyms(char *string, unsigned long int context)
 	bot_synonym_t *synonym, *replacement;
 	float weight, curweight;
 
+	//find all the synonyms in the string
+	BotAutomatonScan(&synonymautomaton, string);
 	for (syn = synonyms; syn; syn = syn->next)
 	{
 		if (!(syn->context & context)) continue;
@@ -801,7 +1026,11 @@ void BotReplaceWeightedSynonyms(char *string, unsigned long int context)
 		for (synonym = syn->firstsynonym; synonym; synonym = synonym->next)
 		{
 			if (synonym == replacement) continue;
-			StringReplaceWords(string, synonym->string, replacement->string);
+			if (!BotAutomatonFound(&synonymautomaton, synonym->pattern)) continue;
+			if (StringReplaceWords(string, synonym->string, replacement->string))
+			{
+				BotAutomatonScan(&synonymautomaton, string);
+			} //end if
 		} //end for
 	} //end for
 } //end of the function BotReplaceWeightedSynonyms
@@ -817,6 +1046,8 @@ void BotReplaceReplySynonyms(char *string, unsigned long int context)
 	bot_synonymlist_t *syn;
 	bot_synonym_t *synonym;
 
+	//find all the synonyms in the string
+	BotAutomatonScan(&synonymautomaton, string);
 	for (str1 = string; *str1; )
 	{
 		//go to the start of the next word
@@ -828,6 +1059,8 @@ void BotReplaceReplySynonyms(char *string, unsigned long int context)
 			if (!(syn->context & context)) continue;
 			for (synonym = syn->firstsynonym->next; synonym; synonym = synonym->next)
 			{
+				//if the synonym isn't anywhere in the string
+				if (!BotAutomatonFound(&synonymautomaton, synonym->pattern)) continue;
 				str2 = synonym->string;
 				//if the synonym is not at the front of the string continue
 				str2 = StringContainsWord(str1, synonym->string, qfalse);
@@ -842,7 +1075,8 @@ void BotReplaceReplySynonyms(char *string, unsigned long int context)
 							strlen(str1+strlen(synonym->string)) + 1);
 				//append the synonum replacement
 				Com_Memcpy(str1, replacement, strlen(replacement));
-				//
+				//the string changed
+				BotAutomatonScan(&synonymautomaton, string);
 				break;
 			} //end for
 			//if a synonym has been replaced
@@ -966,7 +1200,7 @@ bot_randomlist_t *BotLoadRandomStrings(char *filename)
 		if (pass && size) ptr = (char *) GetClearedHunkMemory(size);
 		//
 		PC_SetBaseFolder(BOTFILESBASEFOLDER);
-		source = LoadSourceFile(filename);
+		source = LoadPrecompiledSourceFile(filename);
 		if (!source)
 		{
 			botimport.Print(PRT_ERROR, "counldn't load %s\n", filename);
@@ -1205,6 +1439,7 @@ bot_matchpiece_t *BotLoadMatchPieces(source_t *source, char *endtoken)
 				StripDoubleQuotes(token.string);
 				matchstring = (bot_matchstring_t *) GetClearedHunkMemory(sizeof(bot_matchstring_t) + strlen(token.string) + 1);
 				matchstring->string = (char *) matchstring + sizeof(bot_matchstring_t);
+				matchstring->pattern = -1;
 				strcpy(matchstring->string, token.string);
 				if (!strlen(token.string)) emptystring = qtrue;
 				matchstring->next = NULL;
@@ -1263,7 +1498,7 @@ bot_matchtemplate_t *BotLoadMatchTemplates(char *matchfile)
 	unsigned long int context;
 
 	PC_SetBaseFolder(BOTFILESBASEFOLDER);
-	source = LoadSourceFile(matchfile);
+	source = LoadPrecompiledSourceFile(matchfile);
 	if (!source)
 	{
 		botimport.Print(PRT_ERROR, "counldn't load %s\n", matchfile);
@@ -1426,6 +1661,30 @@ int StringsMatch(bot_matchpiece_t *pieces, bot_match_t *match)
 	return qfalse;
 } //end of the function StringsMatch
 //===========================================================================
+// every fixed piece of a template needs one of its strings somewhere in
+// the string for the template to match
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+int BotMatchTemplatePossible(bot_matchtemplate_t *mt)
+{
+	bot_matchpiece_t *mp;
+	bot_matchstring_t *ms;
+
+	for (mp = mt->first; mp; mp = mp->next)
+	{
+		if (mp->type != MT_STRING) continue;
+		for (ms = mp->firststring; ms; ms = ms->next)
+		{
+			if (BotAutomatonFound(&matchautomaton, ms->pattern)) break;
+		} //end for
+		if (!ms) return qfalse;
+	} //end for
+	return qtrue;
+} //end of the function BotMatchTemplatePossible
+//===========================================================================
 //
 // Parameter:				-
 // Returns:					-
@@ -1443,10 +1702,14 @@ int BotFindMatch(char *str, bot_match_t *match, unsigned long int context)
 	{
 		match->string[strlen(match->string)-1] = '\0';
 	} //end while
+	//find all the match strings in the string
+	BotAutomatonScan(&matchautomaton, match->string);
 	//compare the string with all the match strings
 	for (ms = matchtemplates; ms; ms = ms->next)
 	{
 		if (!(ms->context & context)) continue;
+		//if the template certainly doesn't match
+		if (!BotMatchTemplatePossible(ms)) continue;
 		//reset the match variable offsets
 		for (i = 0; i < MAX_MATCHVARIABLES; i++) match->variables[i].offset = -1;
 		//
@@ -1836,7 +2099,7 @@ bot_replychat_t *BotLoadReplyChat(char *filename)
 	bot_replychatkey_t *key;
 
 	PC_SetBaseFolder(BOTFILESBASEFOLDER);
-	source = LoadSourceFile(filename);
+	source = LoadPrecompiledSourceFile(filename);
 	if (!source)
 	{
 		botimport.Print(PRT_ERROR, "counldn't load %s\n", filename);
@@ -2035,7 +2298,7 @@ bot_chat_t *BotLoadInitialChat(char *chatfile, char *chatname)
 		if (pass && size) ptr = (char *) GetClearedMemory(size);
 		//load the source file
 		PC_SetBaseFolder(BOTFILESBASEFOLDER);
-		source = LoadSourceFile(chatfile);
+		source = LoadPrecompiledSourceFile(chatfile);
 		if (!source)
 		{
 			botimport.Print(PRT_ERROR, "counldn't load %s\n", chatfile);
@@ -2948,6 +3211,44 @@ void BotFreeChatState(int handle)
 // Returns:					-
 // Changes Globals:		-
 //===========================================================================
+void BotBuildChatAutomatons(void)
+{
+	bot_matchtemplate_t *mt;
+	bot_matchpiece_t *mp;
+	bot_matchstring_t *ms;
+	bot_synonymlist_t *syn;
+	bot_synonym_t *synonym;
+
+	BotInitAutomaton(&matchautomaton);
+	for (mt = matchtemplates; mt; mt = mt->next)
+	{
+		for (mp = mt->first; mp; mp = mp->next)
+		{
+			if (mp->type != MT_STRING) continue;
+			for (ms = mp->firststring; ms; ms = ms->next)
+			{
+				ms->pattern = BotAutomatonAddPattern(&matchautomaton, ms->string);
+			} //end for
+		} //end for
+	} //end for
+	BotFinishAutomaton(&matchautomaton);
+	//
+	BotInitAutomaton(&synonymautomaton);
+	for (syn = synonyms; syn; syn = syn->next)
+	{
+		for (synonym = syn->firstsynonym; synonym; synonym = synonym->next)
+		{
+			synonym->pattern = BotAutomatonAddPattern(&synonymautomaton, synonym->string);
+		} //end for
+	} //end for
+	BotFinishAutomaton(&synonymautomaton);
+} //end of the function BotBuildChatAutomatons
+//===========================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
 int BotSetupChatAI(void)
 {
 	char *file;
@@ -2963,6 +3264,8 @@ int BotSetupChatAI(void)
 	file = LibVarString("matchfile", "match.c");
 	matchtemplates = BotLoadMatchTemplates(file);
 	//
+	BotBuildChatAutomatons();
+	//
 	if (!LibVarValue("nochat", "0"))
 	{
 		file = LibVarString("rchatfile", "rchat.c");
@@ -3008,6 +3311,8 @@ void BotShutdownChatAI(void)
 	consolemessageheap = NULL;
 	if (matchtemplates) BotFreeMatchTemplates(matchtemplates);
 	matchtemplates = NULL;
+	BotFreeAutomaton(&matchautomaton);
+	BotFreeAutomaton(&synonymautomaton);
 	if (randomstrings) FreeMemory(randomstrings);
 	randomstrings = NULL;
 	if (synonyms) FreeMemory(synonyms);
@@ -166,6 +166,12 @@ typedef struct bot_goalstate_s
 	struct weightconfig_s *itemweightconfig;	//weight config
 	int *itemweightindex;						//index from item to weight
 	//
+	float *itemweightcache;						//cached fuzzy weights
+	int *cacheinventory;						//inventory the cached weights were calculated for
+	int cacheinventorysize;						//number of inventory entries the weights look at
+	int cachevalid;							//true if the cached weights are valid
+	int weightsgeneration;						//generation of the weights the cache was built for
+	//
 	int client;									//client using this goal state
 	int lastreachabilityarea;					//last area with reachabilities the bot was in
 	//
@@ -192,6 +198,8 @@ campspot_t *campspots = NULL; // bk001206 - init
 int g_gametype = 0; // bk001206 - init
 //additional dropped item weight
 libvar_t *droppedweight = NULL; // bk001206 - init
+//changes every time item weights are mutated or interbreeded
+int itemweightsgeneration = 0;
 
 //========================================================================
 //
@@ -229,6 +237,8 @@ void BotInterbreedGoalFuzzyLogic(int parent1, int parent2, int child)
 
 	InterbreedWeightConfigs(p1->itemweightconfig, p2->itemweightconfig,
 									c->itemweightconfig);
+	//weight configurations can be shared so invalidate all cached weights
+	itemweightsgeneration++;
 } //end of the function BotInterbreedingGoalFuzzyLogic
 //===========================================================================
 //
@@ -257,6 +267,8 @@ void BotMutateGoalFuzzyLogic(int goalstate, float range)
 	gs = BotGoalStateFromHandle(goalstate);
 
 	EvolveWeightConfig(gs->itemweightconfig);
+	//weight configurations can be shared so invalidate all cached weights
+	itemweightsgeneration++;
 } //end of the function BotMutateGoalFuzzyLogic
 //===========================================================================
 //
@@ -283,7 +295,7 @@ itemconfig_t *LoadItemConfig(char *filename)
 
 	strncpy( path, filename, MAX_PATH );
 	PC_SetBaseFolder(BOTFILESBASEFOLDER);
-	source = LoadSourceFile( path );
+	source = LoadPrecompiledSourceFile( path );
 	if( !source ) {
 		botimport.Print( PRT_ERROR, "counldn't load %s\n", path );
 		return NULL;
@@ -1275,6 +1287,116 @@ int BotGetSecondGoal(int goalstate, bot_goal_t *goal)
 	return qtrue;
 } //end of the function BotGetSecondGoal
 //===========================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+int BotFuzzySeperatorMaxIndex_r(fuzzyseperator_t *fs)
+{
+	int maxindex, index;
+
+	maxindex = -1;
+	for (; fs; fs = fs->next)
+	{
+		if (fs->index > maxindex) maxindex = fs->index;
+		if (fs->child)
+		{
+			index = BotFuzzySeperatorMaxIndex_r(fs->child);
+			if (index > maxindex) maxindex = index;
+		} //end if
+	} //end for
+	return maxindex;
+} //end of the function BotFuzzySeperatorMaxIndex_r
+//===========================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+void BotFreeItemWeightCache(bot_goalstate_t *gs)
+{
+	if (gs->itemweightcache) FreeMemory(gs->itemweightcache);
+	gs->itemweightcache = NULL;
+	gs->cacheinventory = NULL;
+	gs->cacheinventorysize = 0;
+} //end of the function BotFreeItemWeightCache
+//===========================================================================
+// allocates the cached item weights and the copy of the inventory
+// they are valid for in one block
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+void BotInitItemWeightCache(bot_goalstate_t *gs)
+{
+	int i, index, maxindex;
+	weightconfig_t *wc;
+
+	BotFreeItemWeightCache(gs);
+	wc = gs->itemweightconfig;
+	if (!wc) return;
+	//the inventory entries the weights depend on
+	maxindex = -1;
+	for (i = 0; i < wc->numweights; i++)
+	{
+		index = BotFuzzySeperatorMaxIndex_r(wc->weights[i].firstseperator);
+		if (index > maxindex) maxindex = index;
+	} //end for
+	gs->cacheinventorysize = maxindex + 1;
+	gs->itemweightcache = (float *) GetClearedMemory(wc->numweights * sizeof(float) +
+								gs->cacheinventorysize * sizeof(int));
+	gs->cacheinventory = (int *) &gs->itemweightcache[wc->numweights];
+	gs->cachevalid = qfalse;
+	gs->weightsgeneration = itemweightsgeneration;
+} //end of the function BotInitItemWeightCache
+//===========================================================================
+// calculates all the item weights again when the inventory or the weights
+// changed since the last time the bot chose an item
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+void BotUpdateItemWeightCache(bot_goalstate_t *gs, int *inventory)
+{
+	if (!gs->itemweightcache || gs->weightsgeneration != itemweightsgeneration)
+	{
+		BotInitItemWeightCache(gs);
+		if (!gs->itemweightcache) return;
+	} //end if
+	if (gs->cachevalid &&
+			!memcmp(gs->cacheinventory, inventory, gs->cacheinventorysize * sizeof(int)))
+	{
+		return;
+	} //end if
+	Com_Memcpy(gs->cacheinventory, inventory, gs->cacheinventorysize * sizeof(int));
+#ifndef UNDECIDEDFUZZY
+	FuzzyWeights(inventory, gs->itemweightconfig, gs->itemweightcache);
+#endif //UNDECIDEDFUZZY
+	gs->cachevalid = qtrue;
+} //end of the function BotUpdateItemWeightCache
+//===========================================================================
+// returns the fuzzy weight for the item, the weights only depend on the
+// inventory so they're only calculated again when the inventory changed
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+float BotItemFuzzyWeight(bot_goalstate_t *gs, int *inventory, int weightnum)
+{
+#ifdef UNDECIDEDFUZZY
+	//undecided weights are different every evaluation
+	return FuzzyWeightUndecided(inventory, gs->itemweightconfig, weightnum);
+#else
+	if (!gs->itemweightcache)
+		return FuzzyWeight(inventory, gs->itemweightconfig, weightnum);
+	return gs->itemweightcache[weightnum];
+#endif //UNDECIDEDFUZZY
+} //end of the function BotItemFuzzyWeight
+//===========================================================================
 // pops a new long term goal on the goal stack in the goalstate
 //
 // Parameter:				-
@@ -1313,6 +1435,8 @@ int BotChooseLTGItem(int goalstate, vec3_t origin, int *inventory, int travelfla
 	ic = itemconfig;
 	if (!itemconfig)
 		return qfalse;
+	//invalidate the cached item weights if the inventory changed
+	BotUpdateItemWeightCache(gs, inventory);
 	//best weight and item so far
 	bestweight = 0;
 	bestitem = NULL;
@@ -1346,11 +1470,7 @@ int BotChooseLTGItem(int goalstate, vec3_t origin, int *inventory, int travelfla
 		if (weightnum < 0)
 			continue;
 
-#ifdef UNDECIDEDFUZZY
-		weight = FuzzyWeightUndecided(inventory, gs->itemweightconfig, weightnum);
-#else
-		weight = FuzzyWeight(inventory, gs->itemweightconfig, weightnum);
-#endif //UNDECIDEDFUZZY
+		weight = BotItemFuzzyWeight(gs, inventory, weightnum);
 #ifdef DROPPEDWEIGHT
 		//HACK: to make dropped items more attractive
 		if (li->timeout)
@@ -1484,6 +1604,8 @@ int BotChooseNBGItem(int goalstate, vec3_t origin, int *inventory, int travelfla
 	ic = itemconfig;
 	if (!itemconfig)
 		return qfalse;
+	//invalidate the cached item weights if the inventory changed
+	BotUpdateItemWeightCache(gs, inventory);
 	//best weight and item so far
 	bestweight = 0;
 	bestitem = NULL;
@@ -1517,11 +1639,7 @@ int BotChooseNBGItem(int goalstate, vec3_t origin, int *inventory, int travelfla
 		if (weightnum < 0)
 			continue;
 		//
-#ifdef UNDECIDEDFUZZY
-		weight = FuzzyWeightUndecided(inventory, gs->itemweightconfig, weightnum);
-#else
-		weight = FuzzyWeight(inventory, gs->itemweightconfig, weightnum);
-#endif //UNDECIDEDFUZZY
+		weight = BotItemFuzzyWeight(gs, inventory, weightnum);
 #ifdef DROPPEDWEIGHT
 		//HACK: to make dropped items more attractive
 		if (li->timeout)
@@ -1704,6 +1822,8 @@ int BotLoadItemWeights(int goalstate, char *filename)
 	if (!itemconfig) return BLERR_CANNOTLOADITEMWEIGHTS;
 	//create the item weight index
 	gs->itemweightindex = ItemWeightIndex(gs->itemweightconfig, itemconfig);
+	//the cached item weights are created the first time they're used
+	BotFreeItemWeightCache(gs);
 	//everything went ok
 	return BLERR_NOERROR;
 } //end of the function BotLoadItemWeights
@@ -1721,6 +1841,7 @@ void BotFreeItemWeights(int goalstate)
 	if (!gs) return;
 	if (gs->itemweightconfig) FreeWeightConfig(gs->itemweightconfig);
 	if (gs->itemweightindex) FreeMemory(gs->itemweightindex);
+	BotFreeItemWeightCache(gs);
 } //end of the function BotFreeItemWeights
 //===========================================================================
 //
@@ -221,7 +221,7 @@ weaponconfig_t *LoadWeaponConfig(char *filename)
 	} //end if
 	strncpy(path, filename, MAX_PATH);
 	PC_SetBaseFolder(BOTFILESBASEFOLDER);
-	source = LoadSourceFile(path);
+	source = LoadPrecompiledSourceFile(path);
 	if (!source)
 	{
 		botimport.Print(PRT_ERROR, "counldn't load %s\n", path);
@@ -47,6 +47,8 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #define MAX_INVENTORYVALUE			999999
 #define EVALUATERECURSIVELY
 
+int CheckFuzzyWeights(weightconfig_t *config);
+
 #define MAX_WEIGHT_FILES			128
 weightconfig_t	*weightFileList[MAX_WEIGHT_FILES];
 
@@ -131,6 +133,7 @@ void FreeWeightConfig2(weightconfig_t *config)
 		FreeFuzzySeperators_r(config->weights[i].firstseperator);
 		if (config->weights[i].name) FreeMemory(config->weights[i].name);
 	} //end for
+	if (config->nodes) FreeMemory(config->nodes);
 	FreeMemory(config);
 } //end of the function FreeWeightConfig2
 //===========================================================================
@@ -276,6 +279,93 @@ fuzzyseperator_t *ReadFuzzySeperators_r(source_t *source)
 // Returns:					-
 // Changes Globals:		-
 //===========================================================================
+int NumFuzzySeperators_r(fuzzyseperator_t *fs)
+{
+	int num;
+
+	for (num = 0; fs; fs = fs->next)
+	{
+		num++;
+		if (fs->child) num += NumFuzzySeperators_r(fs->child);
+	} //end for
+	return num;
+} //end of the function NumFuzzySeperators_r
+//===========================================================================
+// stores the seperators of a switch in consecutive nodes followed by
+// the child switches, returns the first node
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+int CompileFuzzySeperators_r(weightconfig_t *config, fuzzyseperator_t *firstfs)
+{
+	int first, n;
+	fuzzyseperator_t *fs;
+	fuzzynode_t *node;
+
+	first = config->numnodes;
+	for (fs = firstfs; fs; fs = fs->next)
+	{
+		node = &config->nodes[config->numnodes++];
+		node->index = fs->index;
+		node->value = fs->value;
+		node->weight = fs->weight;
+		node->child = -1;
+		if (fs->next) node->next = config->numnodes;
+		else node->next = -1;
+	} //end for
+	for (fs = firstfs, n = first; fs; fs = fs->next, n++)
+	{
+		if (fs->child)
+		{
+			config->nodes[n].child = CompileFuzzySeperators_r(config, fs->child);
+		} //end if
+	} //end for
+	return first;
+} //end of the function CompileFuzzySeperators_r
+//===========================================================================
+// compiles the fuzzy seperators of all the weights into one node array,
+// has to be called again every time the seperator weights change
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+void CompileWeightConfig(weightconfig_t *config)
+{
+	int i, numnodes;
+
+	numnodes = 0;
+	for (i = 0; i < config->numweights; i++)
+	{
+		numnodes += NumFuzzySeperators_r(config->weights[i].firstseperator);
+	} //end for
+	if (config->nodes) FreeMemory(config->nodes);
+	config->nodes = NULL;
+	config->numnodes = 0;
+	if (numnodes)
+	{
+		config->nodes = (fuzzynode_t *) GetClearedMemory(numnodes * sizeof(fuzzynode_t));
+	} //end if
+	for (i = 0; i < config->numweights; i++)
+	{
+		if (config->weights[i].firstseperator)
+		{
+			config->weights[i].firstnode = CompileFuzzySeperators_r(config, config->weights[i].firstseperator);
+		} //end if
+		else
+		{
+			config->weights[i].firstnode = -1;
+		} //end else
+	} //end for
+} //end of the function CompileWeightConfig
+//===========================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
 weightconfig_t *ReadWeightConfig(char *filename)
 {
 	int newindent, avail = 0, n;
@@ -318,7 +408,7 @@ weightconfig_t *ReadWeightConfig(char *filename)
 	} //end if
 
 	PC_SetBaseFolder(BOTFILESBASEFOLDER);
-	source = LoadSourceFile(filename);
+	source = LoadPrecompiledSourceFile(filename);
 	if (!source)
 	{
 		botimport.Print(PRT_ERROR, "counldn't load %s\n", filename);
@@ -419,6 +509,13 @@ weightconfig_t *ReadWeightConfig(char *filename)
 	} //end while
 	//free the source at the end of a pass
 	FreeSource(source);
+	//compile the fuzzy seperators for fast evaluation
+	CompileWeightConfig(config);
+	//compare the compiled weights with the recursive evaluation
+	if (LibVarGetValue("checkweights"))
+	{
+		CheckFuzzyWeights(config);
+	} //end if
 	//if the file was located in a pak file
 	botimport.Print(PRT_MESSAGE, "loaded %s\n", filename);
 #ifdef DEBUG
@@ -643,28 +740,22 @@ float FuzzyWeightUndecided_r(int *inventory, fuzzyseperator_t *fs)
 //===========================================================================
 float FuzzyWeight(int *inventory, weightconfig_t *wc, int weightnum)
 {
-#ifdef EVALUATERECURSIVELY
-	return FuzzyWeight_r(inventory, wc->weights[weightnum].firstseperator);
-#else
-	fuzzyseperator_t *s;
+	int n;
+	fuzzynode_t *node;
 
-	s = wc->weights[weightnum].firstseperator;
-	if (!s) return 0;
-	while(1)
+	//NOTE: FuzzyWeight_r scales between two weights when the inventory value
+	//		is in between two seperator values but the integer division makes the
+	//		scale factor always zero, the result is the weight of the next
+	//		seperator, so the compiled nodes are evaluated without recursion
+	n = wc->weights[weightnum].firstnode;
+	if (n < 0) return 0;
+	do
 	{
-		if (inventory[s->index] < s->value)
-		{
-			if (s->child) s = s->child;
-			else return s->weight;
-		} //end if
-		else
-		{
-			if (s->next) s = s->next;
-			else return s->weight;
-		} //end else
-	} //end if
-	return 0;
-#endif
+		node = &wc->nodes[n];
+		if (inventory[node->index] < node->value) n = node->child;
+		else n = node->next;
+	} while(n >= 0);
+	return node->weight;
 } //end of the function FuzzyWeight
 //===========================================================================
 //
@@ -698,6 +789,113 @@ float FuzzyWeightUndecided(int *inventory, weightconfig_t *wc, int weightnum)
 #endif
 } //end of the function FuzzyWeightUndecided
 //===========================================================================
+// evaluates all the weights of the configuration in one go
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+void FuzzyWeights(int *inventory, weightconfig_t *wc, float *weights)
+{
+	int i;
+
+	for (i = 0; i < wc->numweights; i++)
+	{
+		weights[i] = FuzzyWeight(inventory, wc, i);
+	} //end for
+} //end of the function FuzzyWeights
+//===========================================================================
+// evaluates the weight with the inventory value just below and at every
+// seperator value of the switch and the switches below it, and compares
+// FuzzyWeight_r with the compiled nodes
+//
+// Parameter:				config			: weight configuration
+//							weightnum		: weight to check
+//							fs				: first seperator of the switch
+//							inventory		: inventory to evaluate with
+//							numchecks		: incremented for every evaluation
+// Returns:					number of differing evaluations
+// Changes Globals:		-
+//===========================================================================
+int CheckFuzzySeperators_r(weightconfig_t *config, int weightnum, fuzzyseperator_t *fs,
+							int *inventory, int *numchecks)
+{
+	int i, value, oldvalue, numdiffering;
+	float w1, w2;
+
+	numdiffering = 0;
+	for (; fs; fs = fs->next)
+	{
+		oldvalue = inventory[fs->index];
+		for (i = 0; i < 2; i++)
+		{
+			value = fs->value - 1 + i;
+			inventory[fs->index] = value;
+			w1 = FuzzyWeight_r(inventory, config->weights[weightnum].firstseperator);
+			w2 = FuzzyWeight(inventory, config, weightnum);
+			(*numchecks)++;
+			if (w1 != w2)
+			{
+				Log_Write("%s: weight %s with inventory[%d] = %d is %f recursively and %f compiled\r\n",
+							config->filename, config->weights[weightnum].name, fs->index, value, w1, w2);
+				numdiffering++;
+			} //end if
+			//below the seperator value the child switch is used
+			if (value < fs->value && fs->child)
+			{
+				numdiffering += CheckFuzzySeperators_r(config, weightnum, fs->child, inventory, numchecks);
+			} //end if
+		} //end for
+		inventory[fs->index] = oldvalue;
+	} //end for
+	return numdiffering;
+} //end of the function CheckFuzzySeperators_r
+//===========================================================================
+// checks that the compiled nodes evaluate every weight of the configuration
+// the same as FuzzyWeight_r on both sides of every seperator value
+//
+// Parameter:				config			: weight configuration
+// Returns:					number of differing evaluations
+// Changes Globals:		-
+//===========================================================================
+int CheckFuzzyWeights(weightconfig_t *config)
+{
+	int i, maxindex, numchecks, numdiffering, *inventory;
+
+	maxindex = 0;
+	for (i = 0; i < config->numnodes; i++)
+	{
+		if (config->nodes[i].index < 0)
+		{
+			botimport.Print(PRT_WARNING, "%s: negative inventory index %d\n",
+								config->filename, config->nodes[i].index);
+			return 0;
+		} //end if
+		if (config->nodes[i].index > maxindex) maxindex = config->nodes[i].index;
+	} //end for
+	inventory = (int *) GetClearedMemory((maxindex + 1) * sizeof(int));
+	numchecks = 0;
+	numdiffering = 0;
+	for (i = 0; i < config->numweights; i++)
+	{
+		if (!config->weights[i].firstseperator) continue;
+		numdiffering += CheckFuzzySeperators_r(config, i, config->weights[i].firstseperator,
+													inventory, &numchecks);
+	} //end for
+	FreeMemory(inventory);
+	if (numdiffering)
+	{
+		botimport.Print(PRT_WARNING, "%s: %d of %d weight evaluations differ\n",
+							config->filename, numdiffering, numchecks);
+	} //end if
+	else
+	{
+		botimport.Print(PRT_MESSAGE, "%s: %d weight evaluations identical\n",
+							config->filename, numchecks);
+	} //end else
+	return numdiffering;
+} //end of the function CheckFuzzyWeights
+//===========================================================================
 //
 // Parameter:				-
 // Returns:					-
@@ -734,6 +932,7 @@ void EvolveWeightConfig(weightconfig_t *config)
 	{
 		EvolveFuzzySeperator_r(config->weights[i].firstseperator);
 	} //end for
+	CompileWeightConfig(config);
 } //end of the function EvolveWeightConfig
 //===========================================================================
 //
@@ -777,6 +976,7 @@ void ScaleWeight(weightconfig_t *config, char *name, float scale)
 			break;
 		} //end if
 	} //end for
+	CompileWeightConfig(config);
 } //end of the function ScaleWeight
 //===========================================================================
 //
@@ -890,6 +1090,7 @@ void InterbreedWeightConfigs(weightconfig_t *config1, weightconfig_t *config2,
 									config2->weights[i].firstseperator,
 									configout->weights[i].firstseperator);
 	} //end for
+	CompileWeightConfig(configout);
 } //end of the function InterbreedWeightConfigs
 //===========================================================================
 //
@@ -45,11 +45,22 @@ typedef struct fuzzyseperator_s
 	struct fuzzyseperator_s *next;
 } fuzzyseperator_t;
 
+//compiled fuzzy seperator
+typedef struct fuzzynode_s
+{
+	int index;						//inventory index
+	int value;						//seperator value
+	int child;						//node to continue with when below the value, -1 if none
+	int next;						//node to continue with otherwise, -1 if none
+	float weight;
+} fuzzynode_t;
+
 //fuzzy weight
 typedef struct weight_s
 {
 	char *name;
 	struct fuzzyseperator_s *firstseperator;
+	int firstnode;					//first compiled node, -1 if none
 } weight_t;
 
 //weight configuration
@@ -58,6 +69,8 @@ typedef struct weightconfig_s
 	int numweights;
 	weight_t weights[MAX_WEIGHTS];
 	char		filename[MAX_QPATH];
+	fuzzynode_t *nodes;				//compiled fuzzy seperators of all weights
+	int numnodes;
 } weightconfig_t;
 
 //reads a weight configuration
@@ -71,6 +84,8 @@ int FindFuzzyWeight(weightconfig_t *wc, char *name);
 //returns the fuzzy weight for the given inventory and weight
 float FuzzyWeight(int *inventory, weightconfig_t *wc, int weightnum);
 float FuzzyWeightUndecided(int *inventory, weightconfig_t *wc, int weightnum);
+//stores the fuzzy weights of all the weights in the configuration
+void FuzzyWeights(int *inventory, weightconfig_t *wc, float *weights);
 //scales the weight with the given name
 void ScaleWeight(weightconfig_t *config, char *name, float scale);
 //scale the balance range
@@ -330,6 +330,132 @@ void DumpMemory(void)
 
 #else
 
+//small memory blocks are allocated from size class pools owned by the
+//botlib instead of from the engine zone, the low byte of the memory id
+//of a pool block holds the size class
+#define POOL_ID				0x5a5a5a00l
+#define POOL_CHUNKSIZE		(64 * 1024)
+#define NUM_MEMORYPOOLS		8
+#define MAX_POOLBLOCKSIZE	1152
+
+typedef struct memorypool_s
+{
+	int size;						//size of the blocks without the memory id
+	void *freeblocks;				//linked list with free blocks
+	int numchunks;					//number of chunks allocated for the pool
+	int numallocs;					//total number of allocations
+	int numblocks;					//number of blocks in use
+	int peakblocks;					//maximum number of blocks in use
+} memorypool_t;
+
+//the last size is large enough for a script token_t
+memorypool_t memorypools[NUM_MEMORYPOOLS] = {
+	{16}, {32}, {64}, {128}, {256}, {512}, {1024}, {MAX_POOLBLOCKSIZE}
+};
+
+#ifdef MEMDEBUG
+#define MAX_MEMORYLABELS	1024
+
+typedef struct memorylabel_s
+{
+	char *label;
+	char *file;
+	int line;
+	int numallocs;					//total number of allocations
+	int numbytes;					//total number of bytes allocated
+} memorylabel_t;
+
+memorylabel_t memorylabels[MAX_MEMORYLABELS];
+int nummemorylabels;
+
+//===========================================================================
+// keeps allocation statistics for every place memory is allocated from
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+void AddMemoryLabel(unsigned long size, char *label, char *file, int line)
+{
+	int i;
+	memorylabel_t *ml;
+
+	for (i = 0; i < nummemorylabels; i++)
+	{
+		ml = &memorylabels[i];
+		if (ml->line == line && ml->file == file && ml->label == label) break;
+	} //end for
+	if (i >= nummemorylabels)
+	{
+		if (nummemorylabels >= MAX_MEMORYLABELS) return;
+		ml = &memorylabels[nummemorylabels++];
+		ml->label = label;
+		ml->file = file;
+		ml->line = line;
+		ml->numallocs = 0;
+		ml->numbytes = 0;
+	} //end if
+	ml->numallocs++;
+	ml->numbytes += size;
+} //end of the function AddMemoryLabel
+#endif //MEMDEBUG
+//===========================================================================
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+void *GetPoolMemory(unsigned long size)
+{
+	int i, n, blocksize;
+	memorypool_t *pool;
+	char *chunk;
+	unsigned long int *memid;
+
+	for (i = 0; i < NUM_MEMORYPOOLS; i++)
+	{
+		if (memorypools[i].size >= size) break;
+	} //end for
+	pool = &memorypools[i];
+	blocksize = sizeof(unsigned long int) + pool->size;
+	//if there are no free blocks left allocate a new chunk
+	if (!pool->freeblocks)
+	{
+		chunk = (char *) botimport.GetMemory(POOL_CHUNKSIZE);
+		if (!chunk) return NULL;
+		//the chunks are never freed, the blocks are reused instead
+		for (n = POOL_CHUNKSIZE / blocksize - 1; n >= 0; n--)
+		{
+			memid = (unsigned long int *) (chunk + n * blocksize);
+			*(void **) (memid + 1) = pool->freeblocks;
+			pool->freeblocks = memid;
+		} //end for
+		pool->numchunks++;
+	} //end if
+	memid = (unsigned long int *) pool->freeblocks;
+	pool->freeblocks = *(void **) (memid + 1);
+	*memid = POOL_ID | i;
+	pool->numallocs++;
+	pool->numblocks++;
+	if (pool->numblocks > pool->peakblocks) pool->peakblocks = pool->numblocks;
+	return memid + 1;
+} //end of the function GetPoolMemory
+//===========================================================================
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+void FreePoolMemory(unsigned long int *memid)
+{
+	memorypool_t *pool;
+
+	pool = &memorypools[*memid & 0xff];
+	*memid = 0;
+	*(void **) (memid + 1) = pool->freeblocks;
+	pool->freeblocks = memid;
+	pool->numblocks--;
+} //end of the function FreePoolMemory
 //===========================================================================
 //
 // Parameter:			-
@@ -345,6 +471,10 @@ void *GetMemory(unsigned long size)
 	void *ptr;
 	unsigned long int *memid;
 
+#ifdef MEMDEBUG
+	AddMemoryLabel(size, label, file, line);
+#endif //MEMDEBUG
+	if (size <= MAX_POOLBLOCKSIZE) return GetPoolMemory(size);
 	ptr = botimport.GetMemory(size + sizeof(unsigned long int));
 	if (!ptr) return NULL;
 	memid = (unsigned long int *) ptr;
@@ -387,6 +517,9 @@ void *GetHunkMemory(unsigned long size)
 	void *ptr;
 	unsigned long int *memid;
 
+#ifdef MEMDEBUG
+	AddMemoryLabel(size, label, file, line);
+#endif //MEMDEBUG
 	ptr = botimport.HunkAlloc(size + sizeof(unsigned long int));
 	if (!ptr) return NULL;
 	memid = (unsigned long int *) ptr;
@@ -426,7 +559,11 @@ void FreeMemory(void *ptr)
 
 	memid = (unsigned long int *) ((char *) ptr - sizeof(unsigned long int));
 
-	if (*memid == MEM_ID)
+	if ((*memid & ~0xffl) == POOL_ID && (*memid & 0xff) < NUM_MEMORYPOOLS)
+	{
+		FreePoolMemory(memid);
+	} //end if
+	else if (*memid == MEM_ID)
 	{
 		botimport.FreeMemory(memid);
 	} //end if
@@ -439,7 +576,20 @@ void FreeMemory(void *ptr)
 //===========================================================================
 int AvailableMemory(void)
 {
-	return botimport.AvailableMemory();
+	int i, available, numfree;
+	memorypool_t *pool;
+
+	available = botimport.AvailableMemory();
+	//pool chunks are not returned to the zone so free pool blocks
+	//count as available memory
+	for (i = 0; i < NUM_MEMORYPOOLS; i++)
+	{
+		pool = &memorypools[i];
+		numfree = pool->numchunks * (POOL_CHUNKSIZE / (sizeof(unsigned long int) + pool->size));
+		numfree -= pool->numblocks;
+		available += numfree * pool->size;
+	} //end for
+	return available;
 } //end of the function AvailableMemory
 //===========================================================================
 //
@@ -449,6 +599,19 @@ int AvailableMemory(void)
 //===========================================================================
 void PrintUsedMemorySize(void)
 {
+	int i, numchunks, numbytes;
+	memorypool_t *pool;
+
+	numchunks = 0;
+	numbytes = 0;
+	for (i = 0; i < NUM_MEMORYPOOLS; i++)
+	{
+		pool = &memorypools[i];
+		numchunks += pool->numchunks;
+		numbytes += pool->numblocks * pool->size;
+	} //end for
+	botimport.Print(PRT_MESSAGE, "memory pools: %d KB in %d chunks, %d KB in use\n",
+					(numchunks * POOL_CHUNKSIZE) >> 10, numchunks, numbytes >> 10);
 } //end of the function PrintUsedMemorySize
 //===========================================================================
 //
@@ -458,6 +621,26 @@ void PrintUsedMemorySize(void)
 //===========================================================================
 void PrintMemoryLabels(void)
 {
+	int i;
+	memorypool_t *pool;
+
+	PrintUsedMemorySize();
+	Log_Write("============= Botlib memory log ==============\r\n");
+	Log_Write("\r\n");
+	for (i = 0; i < NUM_MEMORYPOOLS; i++)
+	{
+		pool = &memorypools[i];
+		Log_Write("pool %4d bytes: %4d chunks, %8d allocs, %6d in use, %6d peak\r\n",
+					pool->size, pool->numchunks, pool->numallocs, pool->numblocks, pool->peakblocks);
+	} //end for
+#ifdef MEMDEBUG
+	Log_Write("\r\n");
+	for (i = 0; i < nummemorylabels; i++)
+	{
+		Log_Write("%8d allocs, %10d bytes: %24s line %6d: %s\r\n", memorylabels[i].numallocs,
+					memorylabels[i].numbytes, memorylabels[i].file, memorylabels[i].line, memorylabels[i].label);
+	} //end for
+#endif //MEMDEBUG
 } //end of the function PrintMemoryLabels
 
 #endif
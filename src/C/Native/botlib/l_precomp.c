@@ -60,6 +60,7 @@ typedef enum {qfalse, qtrue}	qboolean;
 #include "l_script.h"
 #include "l_precomp.h"
 #include "l_log.h"
+#include "l_libvar.h"
 #endif //BOTLIB
 
 #ifdef MEQCC
@@ -119,6 +120,11 @@ token_t *freetokens;					//free tokens from the heap
 //list with global defines added to every source loaded
 define_t *globaldefines;
 
+#ifdef BOTLIB
+int PC_ReadPrecompiledToken(source_t *source, token_t *token);
+void PC_FlushPrecompiledSources(void);
+#endif //BOTLIB
+
 //============================================================================
 //
 // Parameter:				-
@@ -1402,6 +1408,10 @@ int PC_AddGlobalDefine(char *string)
 	if (!define) return qfalse;
 	define->next = globaldefines;
 	globaldefines = define;
+#ifdef BOTLIB
+	//the global defines are part of the precompiled sources
+	PC_FlushPrecompiledSources();
+#endif //BOTLIB
 	return qtrue;
 } //end of the function PC_AddGlobalDefine
 //============================================================================
@@ -1419,6 +1429,9 @@ int PC_RemoveGlobalDefine(char *name)
 	if (define)
 	{
 		PC_FreeDefine(define);
+#ifdef BOTLIB
+		PC_FlushPrecompiledSources();
+#endif //BOTLIB
 		return qtrue;
 	} //end if
 	return qfalse;
@@ -1439,6 +1452,9 @@ void PC_RemoveAllGlobalDefines(void)
 		globaldefines = globaldefines->next;
 		PC_FreeDefine(define);
 	} //end for
+#ifdef BOTLIB
+	PC_FlushPrecompiledSources();
+#endif //BOTLIB
 } //end of the function PC_RemoveAllGlobalDefines
 //============================================================================
 //
@@ -2705,6 +2721,10 @@ int PC_ReadToken(source_t *source, token_t *token)
 {
 	define_t *define;
 
+#ifdef BOTLIB
+	//precompiled sources only store fully preprocessed tokens
+	if (source->precompiled) return PC_ReadPrecompiledToken(source, token);
+#endif //BOTLIB
 	while(1)
 	{
 		if (!PC_ReadSourceToken(source, token)) return qfalse;
@@ -3040,6 +3060,317 @@ source_t *LoadSourceMemory(char *ptr, int length, char *name)
 	PC_AddGlobalDefinesToSource(source);
 	return source;
 } //end of the function LoadSourceMemory
+#ifdef BOTLIB
+//============================================================================
+// precompiled sources
+//
+// The fully preprocessed tokens of a source file are stored in one block
+// of memory so sources that are loaded several times, like the two pass
+// chat and synonym loaders or the characters loaded at different skills,
+// are only run through the precompiler once. The precompiled sources are
+// flushed when the global defines change.
+//
+// every token is stored as:
+//
+//   unsigned char type
+//   int subtype
+//   int line
+//   unsigned short length
+//   unsigned long intvalue		(only for numbers)
+//   long double floatvalue		(only for numbers)
+//   char string[length + 1]
+//============================================================================
+
+typedef struct precompiledsource_s
+{
+	char filename[MAX_PATH];				//base folder and file name
+	char *buffer;							//precompiled tokens
+	int size;								//size of the precompiled tokens
+	int numreferences;						//number of sources reading the tokens
+	int flushed;							//true if removed from the list
+	struct precompiledsource_s *next;
+} precompiledsource_t;
+
+extern char basefolder[];
+
+//list with precompiled sources, most recently used first
+precompiledsource_t *precompiledsources;
+//total size of all precompiled sources in the list
+int precompiledsize;
+
+//============================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//============================================================================
+void PC_FreePrecompiledSource(precompiledsource_t *precompiled)
+{
+	if (precompiled->buffer) FreeMemory(precompiled->buffer);
+	FreeMemory(precompiled);
+} //end of the function PC_FreePrecompiledSource
+//============================================================================
+// sources that are still being read are freed with the source
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//============================================================================
+void PC_FlushPrecompiledSources(void)
+{
+	precompiledsource_t *precompiled;
+
+	for (precompiled = precompiledsources; precompiled; precompiled = precompiledsources)
+	{
+		precompiledsources = precompiledsources->next;
+		if (precompiled->numreferences) precompiled->flushed = qtrue;
+		else PC_FreePrecompiledSource(precompiled);
+	} //end for
+	precompiledsize = 0;
+} //end of the function PC_FlushPrecompiledSources
+//============================================================================
+// frees the least recently used precompiled sources that aren't being
+// read until the total size is below the maximum
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//============================================================================
+void PC_LimitPrecompiledSources(int maxsize)
+{
+	precompiledsource_t *precompiled, *prev, *lastfree, *lastfreeprev;
+
+	while(precompiledsize > maxsize)
+	{
+		lastfree = NULL;
+		lastfreeprev = NULL;
+		prev = NULL;
+		for (precompiled = precompiledsources; precompiled; precompiled = precompiled->next)
+		{
+			if (!precompiled->numreferences)
+			{
+				lastfree = precompiled;
+				lastfreeprev = prev;
+			} //end if
+			prev = precompiled;
+		} //end for
+		if (!lastfree) break;
+		if (lastfreeprev) lastfreeprev->next = lastfree->next;
+		else precompiledsources = lastfree->next;
+		precompiledsize -= lastfree->size;
+		PC_FreePrecompiledSource(lastfree);
+	} //end while
+} //end of the function PC_LimitPrecompiledSources
+//============================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//============================================================================
+void PC_WritePrecompiledData(char **buffer, int *size, int *maxsize, void *data, int length)
+{
+	char *newbuffer;
+
+	if (*size + length > *maxsize)
+	{
+		while(*size + length > *maxsize) *maxsize *= 2;
+		newbuffer = (char *) GetMemory(*maxsize);
+		Com_Memcpy(newbuffer, *buffer, *size);
+		FreeMemory(*buffer);
+		*buffer = newbuffer;
+	} //end if
+	Com_Memcpy(*buffer + *size, data, length);
+	*size += length;
+} //end of the function PC_WritePrecompiledData
+//============================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//============================================================================
+void PC_WritePrecompiledToken(char **buffer, int *size, int *maxsize, token_t *token)
+{
+	unsigned char type;
+	unsigned short length;
+
+	type = token->type;
+	length = strlen(token->string);
+	PC_WritePrecompiledData(buffer, size, maxsize, &type, sizeof(type));
+	PC_WritePrecompiledData(buffer, size, maxsize, &token->subtype, sizeof(token->subtype));
+	PC_WritePrecompiledData(buffer, size, maxsize, &token->line, sizeof(token->line));
+	PC_WritePrecompiledData(buffer, size, maxsize, &length, sizeof(length));
+#ifdef NUMBERVALUE
+	if (token->type == TT_NUMBER)
+	{
+		PC_WritePrecompiledData(buffer, size, maxsize, &token->intvalue, sizeof(token->intvalue));
+		PC_WritePrecompiledData(buffer, size, maxsize, &token->floatvalue, sizeof(token->floatvalue));
+	} //end if
+#endif //NUMBERVALUE
+	PC_WritePrecompiledData(buffer, size, maxsize, token->string, length + 1);
+} //end of the function PC_WritePrecompiledToken
+//============================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//============================================================================
+void PC_ReadPrecompiledData(source_t *source, void *data, int length)
+{
+	Com_Memcpy(data, source->precompiled_p, length);
+	source->precompiled_p += length;
+} //end of the function PC_ReadPrecompiledData
+//============================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//============================================================================
+int PC_ReadPrecompiledToken(source_t *source, token_t *token)
+{
+	unsigned char type;
+	unsigned short length;
+	precompiledsource_t *precompiled;
+
+	//tokens that were unread are read first
+	if (source->tokens)
+	{
+		PC_ReadSourceToken(source, token);
+	} //end if
+	else
+	{
+		precompiled = source->precompiled;
+		if (source->precompiled_p >= precompiled->buffer + precompiled->size) return qfalse;
+		PC_ReadPrecompiledData(source, &type, sizeof(type));
+		token->type = type;
+		PC_ReadPrecompiledData(source, &token->subtype, sizeof(token->subtype));
+		PC_ReadPrecompiledData(source, &token->line, sizeof(token->line));
+		PC_ReadPrecompiledData(source, &length, sizeof(length));
+#ifdef NUMBERVALUE
+		if (token->type == TT_NUMBER)
+		{
+			PC_ReadPrecompiledData(source, &token->intvalue, sizeof(token->intvalue));
+			PC_ReadPrecompiledData(source, &token->floatvalue, sizeof(token->floatvalue));
+		} //end if
+		else
+		{
+			token->intvalue = 0;
+			token->floatvalue = 0;
+		} //end else
+#endif //NUMBERVALUE
+		PC_ReadPrecompiledData(source, token->string, length + 1);
+		token->whitespace_p = NULL;
+		token->endwhitespace_p = NULL;
+		token->linescrossed = 0;
+		token->next = NULL;
+		//for error messages
+		source->scriptstack->line = token->line;
+	} //end else
+	//copy token for unreading
+	Com_Memcpy(&source->token, token, sizeof(token_t));
+	return qtrue;
+} //end of the function PC_ReadPrecompiledToken
+//============================================================================
+// runs the whole source file through the precompiler
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//============================================================================
+precompiledsource_t *PC_PrecompileSourceFile(const char *filename, const char *path)
+{
+	int size, maxsize;
+	char *buffer;
+	source_t *source;
+	token_t token;
+	precompiledsource_t *precompiled;
+
+	source = LoadSourceFile(filename);
+	if (!source) return NULL;
+	//
+	size = 0;
+	maxsize = 16384;
+	buffer = (char *) GetMemory(maxsize);
+	//NOTE: an error stops the precompiler just like the end of the
+	//		source, readers get the same tokens either way
+	while(PC_ReadToken(source, &token))
+	{
+		PC_WritePrecompiledToken(&buffer, &size, &maxsize, &token);
+	} //end while
+	FreeSource(source);
+	//
+	precompiled = (precompiledsource_t *) GetClearedMemory(sizeof(precompiledsource_t));
+	Q_strncpyz(precompiled->filename, path, sizeof(precompiled->filename));
+	precompiled->buffer = (char *) GetMemory(size + 1);
+	Com_Memcpy(precompiled->buffer, buffer, size);
+	precompiled->size = size;
+	FreeMemory(buffer);
+	return precompiled;
+} //end of the function PC_PrecompileSourceFile
+//============================================================================
+// loads a source file that is only run through the precompiler once,
+// the source can be read like any other source
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//============================================================================
+source_t *LoadPrecompiledSourceFile(const char *filename)
+{
+	char path[MAX_PATH];
+	source_t *source;
+	script_t *script;
+	precompiledsource_t *precompiled, *prev;
+
+	//always read the latest version of the files when reloading characters
+	if (LibVarGetValue("bot_reloadcharacters")) return LoadSourceFile(filename);
+	//
+	if (strlen(basefolder)) Com_sprintf(path, sizeof(path), "%s/%s", basefolder, filename);
+	else Q_strncpyz(path, filename, sizeof(path));
+	//
+	prev = NULL;
+	for (precompiled = precompiledsources; precompiled; precompiled = precompiled->next)
+	{
+		if (!Q_stricmp(precompiled->filename, path)) break;
+		prev = precompiled;
+	} //end for
+	if (precompiled)
+	{
+		//move to the front of the list
+		if (prev)
+		{
+			prev->next = precompiled->next;
+			precompiled->next = precompiledsources;
+			precompiledsources = precompiled;
+		} //end if
+	} //end if
+	else
+	{
+		precompiled = PC_PrecompileSourceFile(filename, path);
+		if (!precompiled) return NULL;
+		precompiled->next = precompiledsources;
+		precompiledsources = precompiled;
+		precompiledsize += precompiled->size;
+		//the new source is referenced so it's never freed here
+		precompiled->numreferences++;
+		PC_LimitPrecompiledSources(LibVarValue("max_precompiledsize", "4096") * 1024);
+		precompiled->numreferences--;
+	} //end else
+	//empty script for error messages
+	script = LoadScriptMemory("", 0, (char *) filename);
+	script->next = NULL;
+	//
+	source = (source_t *) GetClearedMemory(sizeof(source_t));
+	strncpy(source->filename, filename, MAX_PATH);
+	source->scriptstack = script;
+	source->precompiled = precompiled;
+	source->precompiled_p = precompiled->buffer;
+	precompiled->numreferences++;
+#if DEFINEHASHING
+	source->definehash = GetClearedMemory(DEFINEHASHSIZE * sizeof(define_t *));
+#endif //DEFINEHASHING
+	return source;
+} //end of the function LoadPrecompiledSourceFile
+#endif //BOTLIB
 //============================================================================
 //
 // Parameter:				-
@@ -3099,6 +3430,17 @@ void FreeSource(source_t *source)
 	//
 	if (source->definehash) FreeMemory(source->definehash);
 #endif //DEFINEHASHING
+#ifdef BOTLIB
+	//stop reading the precompiled tokens
+	if (source->precompiled)
+	{
+		source->precompiled->numreferences--;
+		if (source->precompiled->flushed && !source->precompiled->numreferences)
+		{
+			PC_FreePrecompiledSource(source->precompiled);
+		} //end if
+	} //end if
+#endif //BOTLIB
 	//free the source itself
 	FreeMemory(source);
 } //end of the function FreeSource
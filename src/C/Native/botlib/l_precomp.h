@@ -104,6 +104,10 @@ typedef struct source_s
 	indent_t *indentstack;					//stack with indents
 	int skip;								// > 0 if skipping conditional code
 	token_t token;							//last read token
+#ifdef BOTLIB
+	struct precompiledsource_s *precompiled;	//precompiled tokens to read
+	char *precompiled_p;					//current position in the precompiled tokens
+#endif //BOTLIB
 } source_t;
 
 
@@ -147,6 +151,10 @@ void PC_SetPunctuations(source_t *source, punctuation_t *p);
 void PC_SetBaseFolder(char *path);
 //load a source file
 source_t *LoadSourceFile(const char *filename);
+#ifdef BOTLIB
+//load a source file that is only run through the precompiler once
+source_t *LoadPrecompiledSourceFile(const char *filename);
+#endif //BOTLIB
 //load a source from memory
 source_t *LoadSourceMemory(char *ptr, int length, char *name);
 //free the given source
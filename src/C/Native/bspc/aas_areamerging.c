@@ -324,13 +324,24 @@ int AAS_GroundArea(tmp_area_t *tmparea)
 
 void AAS_MergeAreas(void)
 {
-	int side, nummerges, merges, groundfirst;
+	int side, nummerges, merges, groundfirst, numtries;
 	tmp_area_t *tmparea, *othertmparea;
 	tmp_face_t *face;
+	double start_time;
 
 	nummerges = 0;
+	numtries = 0;
+	start_time = I_FloatTime();
 	Log_Write("AAS_MergeAreas\r\n");
 	qprintf("%6d areas merged", 1);
+	//areas never change until they're merged so merging the areas at both
+	//sides of a face will keep failing as long as the face seperates the
+	//same two areas, remember the areas of the faces that failed
+	for (face = tmpaasworld.faces; face; face = face->l_next)
+	{
+		face->nomergeareas[0] = -1;
+		face->nomergeareas[1] = -1;
+	} //end for
 	//
 	groundfirst = true;
 	//for (i = 0; i < 4 || merges; i++)
@@ -368,12 +379,18 @@ void AAS_MergeAreas(void)
 					{
 						if (!AAS_GroundArea(othertmparea)) continue;
 					} //end if
+					//if merging these areas already failed
+					if (face->nomergeareas[0] == face->frontarea->areanum &&
+						face->nomergeareas[1] == face->backarea->areanum) continue;
+					numtries++;
 					if (AAS_TryMergeFaceAreas(face))
 					{
 						qprintf("\r%6d", ++nummerges);
 						merges++;
 						break;
 					} //end if
+					face->nomergeareas[0] = face->frontarea->areanum;
+					face->nomergeareas[1] = face->backarea->areanum;
 				} //end if
 			} //end for
 		} //end for
@@ -385,6 +402,7 @@ void AAS_MergeAreas(void)
 	} //end for
 	qprintf("\n");
 	Log_Write("%6d areas merged\r\n", nummerges);
+	Log_Write("%6d area merges tried in %5.1f seconds\r\n", numtries, I_FloatTime() - start_time);
 	//refresh the merged tree
 	AAS_RefreshMergedTree_r(tmpaasworld.nodes);
 } //end of the function AAS_MergeAreas
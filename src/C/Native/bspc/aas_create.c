@@ -515,22 +515,47 @@ void AAS_FlipAreaFaces(tmp_area_t *tmparea)
 // Returns:					-
 // Changes Globals:		-
 //===========================================================================
+tmp_face_t **colinearfaces;
+
+void AAS_RemoveFaceColinearPoints(int start, int end)
+{
+	int i;
+
+	for (i = start; i < end; i++)
+	{
+		RemoveColinearPoints(colinearfaces[i]->winding);
+//		RemoveEqualPoints(colinearfaces[i]->winding, 0.1);
+	} //end for
+} //end of the function AAS_RemoveFaceColinearPoints
+//===========================================================================
+// every face winding is only changed by one thread so the faces can
+// be processed in parallel
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
 void AAS_RemoveAreaFaceColinearPoints(void)
 {
-	int side;
+	int numfaces;
 	tmp_face_t *face;
-	tmp_area_t *tmparea;
 
-	//FIXME: loop over the faces instead of area->faces
-	for (tmparea = tmpaasworld.areas; tmparea; tmparea = tmparea->l_next)
+	numfaces = 0;
+	for (face = tmpaasworld.faces; face; face = face->l_next)
 	{
-		for (face = tmparea->tmpfaces; face; face = face->next[side])
-		{
-			side = face->frontarea != tmparea;
-			RemoveColinearPoints(face->winding);
-//			RemoveEqualPoints(face->winding, 0.1);
-		} //end for
+		if (!face->frontarea && !face->backarea) continue;
+		numfaces++;
+	} //end for
+	colinearfaces = (tmp_face_t **) GetMemory((numfaces + 1) * sizeof(tmp_face_t *));
+	numfaces = 0;
+	for (face = tmpaasworld.faces; face; face = face->l_next)
+	{
+		if (!face->frontarea && !face->backarea) continue;
+		colinearfaces[numfaces++] = face;
 	} //end for
+	RunThreadsOnChunked(numfaces, 256, false, AAS_RemoveFaceColinearPoints);
+	FreeMemory(colinearfaces);
+	colinearfaces = NULL;
 } //end of the function AAS_RemoveAreaFaceColinearPoints
 //===========================================================================
 //
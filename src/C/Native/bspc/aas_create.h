@@ -32,6 +32,7 @@ typedef struct tmp_face_s
 	struct tmp_area_s *backarea;	//area at the back of the face
 	int faceflags;					//flags of this face
 	int aasfacenum;					//the number of the aas face used for this face
+	int nomergeareas[2];			//front and back area number when merging these areas failed
 	//double link list pointers for front and back area
 	struct tmp_face_s *prev[2], *next[2];
 	//links in the list with faces
@@ -93,7 +93,9 @@ void AAS_MeltAreaFaceWindings(void)
 {
 	tmp_area_t *tmparea;
 	int num_windingsplits = 0;
+	double start_time;
 
+	start_time = I_FloatTime();
 	Log_Write("AAS_MeltAreaFaceWindings\r\n");
 	qprintf("%6d edges melted", num_windingsplits);
 	//NOTE: first convex area (zero) is a dummy
@@ -103,6 +105,6 @@ void AAS_MeltAreaFaceWindings(void)
 		qprintf("\r%6d", num_windingsplits);
 	} //end for
 	qprintf("\n");
-	Log_Write("%6d edges melted\r\n", num_windingsplits);
+	Log_Write("%6d edges melted in %5.1f seconds\r\n", num_windingsplits, I_FloatTime() - start_time);
 } //end of the function AAS_MeltAreaFaceWindings
 
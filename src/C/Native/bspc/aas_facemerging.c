@@ -129,12 +129,16 @@ int AAS_TryMergeFaces(tmp_face_t *face1, tmp_face_t *face2)
 void AAS_MergeAreaFaces(void)
 {
 	int num_facemerges = 0;
-	int side1, side2, restart;
-	tmp_area_t *tmparea, *lasttmparea;
-	tmp_face_t *face1, *face2;
+	int side1, side2, restart, tested;
+	tmp_area_t *tmparea, *lasttmparea, *mergedarea;
+	tmp_face_t *face1, *face2, *mergedface;
+	double start_time;
 
+	start_time = I_FloatTime();
 	Log_Write("AAS_MergeAreaFaces\r\n");
 	qprintf("%6d face merges", num_facemerges);
+	mergedface = NULL;
+	mergedarea = NULL;
 	//NOTE: first convex area is a dummy
 	lasttmparea = tmpaasworld.areas;
 	for (tmparea = tmpaasworld.areas; tmparea; tmparea = tmparea->l_next)
@@ -142,18 +146,26 @@ void AAS_MergeAreaFaces(void)
 		restart = false;
 		//
 		if (tmparea->invalid) continue;
+		//all faces before the last merged face have already been tested
+		//against all the other (unchanged) faces of the area, this only
+		//holds when the loop restarts at the area the faces were merged in
+		tested = (mergedface != NULL && mergedarea == tmparea);
 		//
 		for (face1 = tmparea->tmpfaces; face1; face1 = face1->next[side1])
 		{
 			side1 = face1->frontarea != tmparea;
+			if (face1 == mergedface) tested = false;
 			for (face2 = face1->next[side1]; face2; face2 = face2->next[side2])
 			{
 				side2 = face2->frontarea != tmparea;
+				if (tested && face2 != mergedface) continue;
 				//if succesfully merged
 				if (AAS_TryMergeFaces(face1, face2))
 				{
 					//start over again after merging two faces
 					restart = true;
+					mergedface = face1;
+					mergedarea = tmparea;
 					num_facemerges++;
 					qprintf("\r%6d", num_facemerges);
 					AAS_CheckArea(tmparea);
@@ -166,10 +178,11 @@ void AAS_MergeAreaFaces(void)
 				break;
 			} //end if
 		} //end for
+		if (!restart) mergedface = NULL;
 		lasttmparea = tmparea;
 	} //end for
 	qprintf("\n");
-	Log_Write("%6d face merges\r\n", num_facemerges);
+	Log_Write("%6d face merges in %5.1f seconds\r\n", num_facemerges, I_FloatTime() - start_time);
 } //end of the function AAS_MergeAreaFaces
 //===========================================================================
 //
@@ -253,7 +266,9 @@ void AAS_MergeAreaPlaneFaces(void)
 	int side1;
 	tmp_area_t *tmparea, *nexttmparea;
 	tmp_face_t *face1;
+	double start_time;
 
+	start_time = I_FloatTime();
 	Log_Write("AAS_MergePlaneFaces\r\n");
 	qprintf("%6d plane face merges", num_facemerges);
 	//NOTE: first convex area is a dummy
@@ -278,5 +293,5 @@ void AAS_MergeAreaPlaneFaces(void)
 		} //end for
 	} //end for
 	qprintf("\n");
-	Log_Write("%6d plane face merges\r\n", num_facemerges);
+	Log_Write("%6d plane face merges in %5.1f seconds\r\n", num_facemerges, I_FloatTime() - start_time);
 } //end of the function AAS_MergeAreaPlaneFaces
@@ -45,19 +45,36 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #define PLANE_HASH_SIZE			1024		//must be power of 2
 //
 #define EDGE_HASHING
-#define EDGE_HASH_SIZE			1024		//must be power of 2
 
 aas_t aasworld;
 
+//vertex hash slot, holds the vertexes with the same rounded coordinates
+typedef struct aas_vertexhash_s
+{
+	int v[3];								//rounded coordinates
+	int firstvertex;						//first vertex in the slot chain, -1 for an empty slot
+} aas_vertexhash_t;
+//edge hash slot
+typedef struct aas_edgehash_s
+{
+	int v[2];								//lowest and highest vertex number of the edge
+	int edgenum;							//the edge, 0 for an empty slot
+} aas_edgehash_t;
+
 //vertex hash
 int *aas_vertexchain;						// the next vertex in a hash chain
-int aas_hashverts[VERTEX_HASH_SIZE*VERTEX_HASH_SIZE];	// a vertex number, or 0 for no verts
+aas_vertexhash_t *aas_hashverts;			// open addressing table with vertex slots
+int aas_vertexhashsize;						// size of the vertex hash, power of 2
 //plane hash
 int *aas_planechain;
 int aas_hashplanes[PLANE_HASH_SIZE];
 //edge hash
-int *aas_edgechain;
-int aas_hashedges[EDGE_HASH_SIZE];
+aas_edgehash_t *aas_hashedges;				// open addressing table with edges
+int aas_edgehashsize;						// size of the edge hash, power of 2
+//hash statistics
+int aas_numvertexlookups, aas_numvertexprobes, aas_maxvertexprobes;
+int aas_numedgelookups, aas_numedgeprobes, aas_maxedgeprobes;
+int aas_numplanelookups, aas_numplaneprobes, aas_maxplaneprobes;
 
 int allocatedaasmem = 0;
 
@@ -141,6 +158,20 @@ void AAS_InitMaxAAS(void)
 // Returns:					-
 // Changes Globals:		-
 //===========================================================================
+int AAS_HashTableSize(int maxitems)
+{
+	int size;
+
+	for (size = 1024; size < maxitems * 2; size <<= 1)
+		;
+	return size;
+} //end of the function AAS_HashTableSize
+//===========================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
 void AAS_AllocMaxAAS(void)
 {
 	int i;
@@ -209,16 +240,21 @@ void AAS_AllocMaxAAS(void)
 	//reset the has stuff
 	aas_vertexchain = (int *) GetClearedMemory(max_aas.max_vertexes * sizeof(int));
 	aas_planechain = (int *) GetClearedMemory(max_aas.max_planes * sizeof(int));
-	aas_edgechain = (int *) GetClearedMemory(max_aas.max_edges * sizeof(int));
+	//keep the open addressing tables at most half full
+	aas_vertexhashsize = AAS_HashTableSize(max_aas.max_vertexes);
+	aas_hashverts = (aas_vertexhash_t *) GetClearedMemory(aas_vertexhashsize * sizeof(aas_vertexhash_t));
+	aas_edgehashsize = AAS_HashTableSize(max_aas.max_edges);
+	aas_hashedges = (aas_edgehash_t *) GetClearedMemory(aas_edgehashsize * sizeof(aas_edgehash_t));
 	//
 	for (i = 0; i < max_aas.max_vertexes; i++) aas_vertexchain[i] = -1;
-	for (i = 0; i < VERTEX_HASH_SIZE * VERTEX_HASH_SIZE; i++) aas_hashverts[i] = -1;
+	for (i = 0; i < aas_vertexhashsize; i++) aas_hashverts[i].firstvertex = -1;
 	//
 	for (i = 0; i < max_aas.max_planes; i++) aas_planechain[i] = -1;
 	for (i = 0; i < PLANE_HASH_SIZE; i++) aas_hashplanes[i] = -1;
 	//
-	for (i = 0; i < max_aas.max_edges; i++) aas_edgechain[i] = -1;
-	for (i = 0; i < EDGE_HASH_SIZE; i++) aas_hashedges[i] = -1;
+	aas_numvertexlookups = aas_numvertexprobes = aas_maxvertexprobes = 0;
+	aas_numedgelookups = aas_numedgeprobes = aas_maxedgeprobes = 0;
+	aas_numplanelookups = aas_numplaneprobes = aas_maxplaneprobes = 0;
 } //end of the function AAS_AllocMaxAAS
 //===========================================================================
 //
@@ -292,10 +328,12 @@ void AAS_FreeMaxAAS(void)
 	//
 	if (aas_vertexchain) FreeMemory(aas_vertexchain);
 	aas_vertexchain = NULL;
+	if (aas_hashverts) FreeMemory(aas_hashverts);
+	aas_hashverts = NULL;
 	if (aas_planechain) FreeMemory(aas_planechain);
 	aas_planechain = NULL;
-	if (aas_edgechain) FreeMemory(aas_edgechain);
-	aas_edgechain = NULL;
+	if (aas_hashedges) FreeMemory(aas_hashedges);
+	aas_hashedges = NULL;
 } //end of the function AAS_FreeMaxAAS
 //===========================================================================
 //
@@ -320,6 +358,27 @@ unsigned AAS_HashVec(vec3_t vec)
 	return y*VERTEX_HASH_SIZE + x;
 } //end of the function AAS_HashVec
 //===========================================================================
+// returns the slot in the vertex hash for the given rounded coordinates,
+// the slot is empty if there are no vertexes with these coordinates
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+aas_vertexhash_t *AAS_VertexHashSlot(int v[3])
+{
+	unsigned h;
+	aas_vertexhash_t *slot;
+
+	h = ((unsigned) v[0] * 73856093) ^ ((unsigned) v[1] * 19349663) ^ ((unsigned) v[2] * 83492791);
+	for (h &= aas_vertexhashsize - 1; ; h = (h + 1) & (aas_vertexhashsize - 1))
+	{
+		slot = &aas_hashverts[h];
+		if (slot->firstvertex < 0) return slot;
+		if (slot->v[0] == v[0] && slot->v[1] == v[1] && slot->v[2] == v[2]) return slot;
+	} //end for
+} //end of the function AAS_VertexHashSlot
+//===========================================================================
 // returns true if the vertex was found in the list
 // stores the vertex number in *vnum
 // stores a new vertex if not stored already
@@ -336,8 +395,10 @@ qboolean AAS_GetVertex(vec3_t v, int *vnum)
 #endif //VERTEX_HASHING
 
 #ifdef VERTEX_HASHING
-	int h, vn;
+	int h, vn, x, y, z, probes;
+	int mins[3], maxs[3], key[3], slotkey[3];
 	vec3_t vert;
+	aas_vertexhash_t *slot;
 	
 	for (i = 0; i < 3; i++)
 	{
@@ -355,16 +416,50 @@ qboolean AAS_GetVertex(vec3_t v, int *vnum)
 		return true;
 	} //end if
 
-	for (vn = aas_hashverts[h]; vn >= 0; vn = aas_vertexchain[vn])
+	//the vertexes are stored with their coordinates rounded the same way
+	//AAS_HashVec does, every vertex within VERTEX_EPSILON of vert is stored
+	//in one of the slots between mins and maxs
+	for (i = 0; i < 3; i++)
+	{
+		key[i] = (int)(vert[i]+0.5);
+		mins[i] = (int)(vert[i]-2*VERTEX_EPSILON+0.5);
+		maxs[i] = (int)(vert[i]+2*VERTEX_EPSILON+0.5);
+	} //end for
+	//use the last stored vertex within VERTEX_EPSILON that is in the same
+	//AAS_HashVec bin, just like a search through a single hash bin would
+	*vnum = -1;
+	probes = 0;
+	for (x = mins[0]; x <= maxs[0]; x++)
 	{
-		if (fabs(aasworld.vertexes[vn][0] - vert[0]) < VERTEX_EPSILON
-				&& fabs(aasworld.vertexes[vn][1] - vert[1]) < VERTEX_EPSILON
-				&& fabs(aasworld.vertexes[vn][2] - vert[2]) < VERTEX_EPSILON)
+		for (y = mins[1]; y <= maxs[1]; y++)
 		{
-			*vnum = vn;
-			return true;
-		} //end if
+			//only vertexes in the same bin
+			if (((MAX_MAP_BOUNDS + x) >> VERTEX_HASH_SHIFT) != ((MAX_MAP_BOUNDS + key[0]) >> VERTEX_HASH_SHIFT) ||
+				((MAX_MAP_BOUNDS + y) >> VERTEX_HASH_SHIFT) != ((MAX_MAP_BOUNDS + key[1]) >> VERTEX_HASH_SHIFT)) continue;
+			for (z = mins[2]; z <= maxs[2]; z++)
+			{
+				slotkey[0] = x;
+				slotkey[1] = y;
+				slotkey[2] = z;
+				slot = AAS_VertexHashSlot(slotkey);
+				for (vn = slot->firstvertex; vn > *vnum; vn = aas_vertexchain[vn])
+				{
+					probes++;
+					if (fabs(aasworld.vertexes[vn][0] - vert[0]) < VERTEX_EPSILON
+							&& fabs(aasworld.vertexes[vn][1] - vert[1]) < VERTEX_EPSILON
+							&& fabs(aasworld.vertexes[vn][2] - vert[2]) < VERTEX_EPSILON)
+					{
+						*vnum = vn;
+						break;
+					} //end if
+				} //end for
+			} //end for
+		} //end for
 	} //end for
+	aas_numvertexlookups++;
+	aas_numvertexprobes += probes;
+	if (probes > aas_maxvertexprobes) aas_maxvertexprobes = probes;
+	if (*vnum >= 0) return true;
 #else //VERTEX_HASHING
 	//check if the vertex is already stored
 	//stupid linear search
@@ -395,8 +490,15 @@ qboolean AAS_GetVertex(vec3_t v, int *vnum)
 	*vnum = aasworld.numvertexes;
 
 #ifdef VERTEX_HASHING
-	aas_vertexchain[aasworld.numvertexes] = aas_hashverts[h];
-	aas_hashverts[h] = aasworld.numvertexes;
+	slot = AAS_VertexHashSlot(key);
+	if (slot->firstvertex < 0)
+	{
+		slot->v[0] = key[0];
+		slot->v[1] = key[1];
+		slot->v[2] = key[2];
+	} //end if
+	aas_vertexchain[aasworld.numvertexes] = slot->firstvertex;
+	slot->firstvertex = aasworld.numvertexes;
 #endif //VERTEX_HASHING
 
 	aasworld.numvertexes++;
@@ -408,9 +510,11 @@ qboolean AAS_GetVertex(vec3_t v, int *vnum)
 // Returns:					-
 // Changes Globals:		-
 //===========================================================================
-unsigned AAS_HashEdge(int v1, int v2)
+aas_edgehash_t *AAS_EdgeHashSlot(int v1, int v2)
 {
-	int vnum1, vnum2;
+	int vnum1, vnum2, probes;
+	unsigned h;
+	aas_edgehash_t *slot;
 	//
 	if (v1 < v2)
 	{
@@ -422,8 +526,20 @@ unsigned AAS_HashEdge(int v1, int v2)
 		vnum1 = v2;
 		vnum2 = v1;
 	} //end else
-	return (vnum1 + vnum2) & (EDGE_HASH_SIZE-1);
-} //end of the function AAS_HashVec
+	probes = 0;
+	h = ((unsigned) vnum1 * 73856093) ^ ((unsigned) vnum2 * 19349663);
+	for (h &= aas_edgehashsize - 1; ; h = (h + 1) & (aas_edgehashsize - 1))
+	{
+		probes++;
+		slot = &aas_hashedges[h];
+		if (!slot->edgenum) break;
+		if (slot->v[0] == vnum1 && slot->v[1] == vnum2) break;
+	} //end for
+	aas_numedgelookups++;
+	aas_numedgeprobes += probes;
+	if (probes > aas_maxedgeprobes) aas_maxedgeprobes = probes;
+	return slot;
+} //end of the function AAS_EdgeHashSlot
 //===========================================================================
 //
 // Parameter:				-
@@ -432,17 +548,26 @@ unsigned AAS_HashEdge(int v1, int v2)
 //===========================================================================
 void AAS_AddEdgeToHash(int edgenum)
 {
-	int hash;
 	aas_edge_t *edge;
+	aas_edgehash_t *slot;
 
 	edge = &aasworld.edges[edgenum];
-
-	hash = AAS_HashEdge(edge->v[0], edge->v[1]);
-
-	aas_edgechain[edgenum] = aas_hashedges[hash];
-	aas_hashedges[hash] = edgenum;
+	slot = AAS_EdgeHashSlot(edge->v[0], edge->v[1]);
+	if (edge->v[0] < edge->v[1])
+	{
+		slot->v[0] = edge->v[0];
+		slot->v[1] = edge->v[1];
+	} //end if
+	else
+	{
+		slot->v[0] = edge->v[1];
+		slot->v[1] = edge->v[0];
+	} //end else
+	slot->edgenum = edgenum;
 } //end of the function AAS_AddEdgeToHash
 //===========================================================================
+// there's only one edge between two vertexes because edges are only
+// stored when not found
 //
 // Parameter:				-
 // Returns:					-
@@ -450,33 +575,15 @@ void AAS_AddEdgeToHash(int edgenum)
 //===========================================================================
 qboolean AAS_FindHashedEdge(int v1num, int v2num, int *edgenum)
 {
-	int e, hash;
-	aas_edge_t *edge;
+	int e;
 
-	hash = AAS_HashEdge(v1num, v2num);
-	for (e = aas_hashedges[hash]; e >= 0; e = aas_edgechain[e])
-	{
-		edge = &aasworld.edges[e];
-		if (edge->v[0] == v1num)
-		{
-			if (edge->v[1] == v2num)
-			{
-				*edgenum = e;
-				return true;
-			} //end if
-		} //end if
-		else if (edge->v[1] == v1num)
-		{
-			if (edge->v[0] == v2num)
-			{
-				//negative for a reversed edge
-				*edgenum = -e;
-				return true;
-			} //end if
-		} //end else
-	} //end for
-	return false;
-} //end of the function AAS_FindHashedPlane
+	e = AAS_EdgeHashSlot(v1num, v2num)->edgenum;
+	if (!e) return false;
+	if (aasworld.edges[e].v[0] == v1num) *edgenum = e;
+	//negative for a reversed edge
+	else *edgenum = -e;
+	return true;
+} //end of the function AAS_FindHashedEdge
 //===========================================================================
 // returns true if the edge was found
 // stores the edge number in *edgenum (negative if reversed edge)
@@ -653,28 +760,32 @@ qboolean AAS_FindPlane(vec3_t normal, float dist, int *planenum)
 //===========================================================================
 qboolean AAS_FindHashedPlane(vec3_t normal, float dist, int *planenum)
 {
-	int i, p;
-	aas_plane_t *plane;
+	int i, p, probes;
 	int hash, h;
 
 	hash = (int)fabs(dist) / 8;
 	hash &= (PLANE_HASH_SIZE-1);
 
+	probes = 0;
+	*planenum = -1;
 	//search the border bins as well
-	for (i = -1; i <= 1; i++)
+	for (i = -1; i <= 1 && *planenum < 0; i++)
 	{
 		h = (hash+i)&(PLANE_HASH_SIZE-1);
 		for (p = aas_hashplanes[h]; p >= 0; p = aas_planechain[p])
 		{
-			plane = &aasworld.planes[p];
+			probes++;
 			if (AAS_PlaneEqual(normal, dist, p))
 			{
 				*planenum = p;
-				return true;
+				break;
 			} //end if
 		} //end for
 	} //end for
-	return false;
+	aas_numplanelookups++;
+	aas_numplaneprobes += probes;
+	if (probes > aas_maxplaneprobes) aas_maxplaneprobes = probes;
+	return *planenum >= 0;
 } //end of the function AAS_FindHashedPlane
 //===========================================================================
 //
@@ -1065,6 +1176,33 @@ void AAS_StoreBoundingBoxes(void)
 // Returns:					-
 // Changes Globals:		-
 //===========================================================================
+void AAS_PrintHashStatistics(void)
+{
+	if (aas_numvertexlookups)
+	{
+		Log_Write("%6d vertex lookups, %5.2f average and %d max vertexes compared\r\n",
+					aas_numvertexlookups, (float) aas_numvertexprobes / aas_numvertexlookups,
+					aas_maxvertexprobes);
+	} //end if
+	if (aas_numedgelookups)
+	{
+		Log_Write("%6d edge lookups, %5.2f average and %d max hash slots probed\r\n",
+					aas_numedgelookups, (float) aas_numedgeprobes / aas_numedgelookups,
+					aas_maxedgeprobes);
+	} //end if
+	if (aas_numplanelookups)
+	{
+		Log_Write("%6d plane lookups, %5.2f average and %d max planes compared\r\n",
+					aas_numplanelookups, (float) aas_numplaneprobes / aas_numplanelookups,
+					aas_maxplaneprobes);
+	} //end if
+} //end of the function AAS_PrintHashStatistics
+//===========================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
 void AAS_StoreFile(char *filename)
 {
 	AAS_AllocMaxAAS();
@@ -1078,5 +1216,6 @@ void AAS_StoreFile(char *filename)
 	AAS_StoreTree_r(tmpaasworld.nodes);
 	qprintf("\n");
 	Log_Write("%6d areas stored\r\n", aasworld.numareas);
+	AAS_PrintHashStatistics();
 	aasworld.loaded = true;
 } //end of the function AAS_StoreFile
@@ -1604,6 +1604,76 @@ void IncreaseNodeCounter(void)
 	//qprintf("\r%6d %d, %5d ", numrecurse++, GetNumThreads(), nodelistsize);
 	ThreadUnlock();
 } //end of the function IncreaseNodeCounter
+//per thread build state
+#define MAX_BUILDTREETHREADS		64
+
+typedef struct buildtreethread_s
+{
+	node_t *localnodes;			//nodes only this thread will process (stack)
+	int numlocalnodes;			//number of nodes on the local stack
+	int numnodes;				//number of nodes processed by this thread
+	int numsolidleafs;			//number of solid leafs created by this thread
+	int numdonated;				//number of local nodes handed to idle threads
+} buildtreethread_t;
+
+buildtreethread_t buildtreethreads[MAX_BUILDTREETHREADS];
+int numbuildtreethreads;
+
+//claims the build state for a thread that just started
+buildtreethread_t *BuildTreeThreadState(void)
+{
+	buildtreethread_t *bt;
+
+	ThreadLock();
+	if (numbuildtreethreads >= MAX_BUILDTREETHREADS)
+		Error("more than %d bsp build threads", MAX_BUILDTREETHREADS);
+	bt = &buildtreethreads[numbuildtreethreads++];
+	ThreadUnlock();
+	memset(bt, 0, sizeof(buildtreethread_t));
+	return bt;
+} //end of the function BuildTreeThreadState
+//keeps a node to be processed later by the thread itself, if other
+//threads are idle the oldest local node (the one at the bottom of the
+//stack which has the largest subtree) is handed over to the shared list
+void KeepNodeLocal(buildtreethread_t *bt, node_t *node)
+{
+	node_t *n, *last;
+
+	//a breadth first build has to go through the shared queue
+	if (use_nodequeue)
+	{
+		AddNodeToList(node);
+		return;
+	} //end if
+	node->next = bt->localnodes;
+	bt->localnodes = node;
+	bt->numlocalnodes++;
+	//numwaiting is only peeked at here, a stale value just delays or
+	//causes an extra hand over
+	if (numthreads > 1 && numwaiting > 0 && bt->numlocalnodes > 1)
+	{
+		last = NULL;
+		for (n = bt->localnodes; n->next; n = n->next) last = n;
+		last->next = NULL;
+		bt->numlocalnodes--;
+		bt->numdonated++;
+		AddNodeToList(n);
+	} //end if
+} //end of the function KeepNodeLocal
+//get the next node to process, local nodes first
+node_t *NextNode(buildtreethread_t *bt)
+{
+	node_t *node;
+
+	if (bt->localnodes)
+	{
+		node = bt->localnodes;
+		bt->localnodes = node->next;
+		bt->numlocalnodes--;
+		return node;
+	} //end if
+	return NextNodeFromList();
+} //end of the function NextNode
 //thread function, gets nodes from the nodelist and processes them
 void BuildTreeThread(int threadid)
 {
@@ -1611,6 +1681,9 @@ void BuildTreeThread(int threadid)
 	side_t *bestside;
 	int i, totalmem;
 	bspbrush_t *brushes;
+	buildtreethread_t *bt;
+
+	bt = BuildTreeThreadState();
 
 	for (node = NextNodeFromList(); node; )
 	{
@@ -1629,8 +1702,8 @@ void BuildTreeThread(int threadid)
 			{
 				c_peak_totalbspmemory = totalmem;
 			} //end if
-			c_nodes++;
 		} //endif
+		bt->numnodes++;
 
 		if (drawflag)
 		{
@@ -1651,7 +1724,7 @@ void BuildTreeThread(int threadid)
 		{
 			//create a leaf out of the node
 			LeafNode(node, brushes);
-			if (node->contents & CONTENTS_SOLID) c_solidleafnodes++;
+			if (node->contents & CONTENTS_SOLID) bt->numsolidleafs++;
 			if (create_aas)
 			{
 				//free up memory!!!
@@ -1664,7 +1737,7 @@ void BuildTreeThread(int threadid)
 				FreeBrush(node->volume);
 				node->volume = NULL;
 			} //end if
-			node = NextNodeFromList();
+			node = NextNode(bt);
 			continue;
 		} //end if
 
@@ -1703,9 +1776,8 @@ void BuildTreeThread(int threadid)
 			FreeBrush(node->volume);
 			node->volume = NULL;
 		} //end if
-		//add both children to the node list
-		//AddNodeToList(node->children[0]);
-		AddNodeToList(node->children[1]);
+		//keep the second child for later and continue with the first
+		KeepNodeLocal(bt, node->children[1]);
 		node = node->children[0];
 	} //end while
 	RemoveThread(threadid);
@@ -1719,10 +1791,11 @@ void BuildTreeThread(int threadid)
 //===========================================================================
 void BuildTree(tree_t *tree)
 {
-	int i;
+	int i, numdonated;
 
 	firstnode = NULL;
 	lastnode = NULL;
+	numbuildtreethreads = 0;
 	//use a node queue or node stack
 	if (use_nodequeue) AddNodeToList = AddNodeToQueue;
 	else AddNodeToList = AddNodeToStack;
@@ -1745,6 +1818,20 @@ void BuildTree(tree_t *tree)
 	//shutdown the thread locking
 	ThreadShutdownLock();
 	ThreadShutdownSemaphore();
+	//gather the statistics of all the threads
+	numrecurse = 0;
+	numdonated = 0;
+	for (i = 0; i < numbuildtreethreads; i++)
+	{
+		numrecurse += buildtreethreads[i].numnodes;
+		c_nodes += buildtreethreads[i].numnodes;
+		c_solidleafnodes += buildtreethreads[i].numsolidleafs;
+		numdonated += buildtreethreads[i].numdonated;
+	} //end for
+	if (numthreads > 1)
+	{
+		Log_Print("%6d nodes handed to idle threads\n", numdonated);
+	} //end if
 } //end of the function BuildTree
 //===========================================================================
 // The incoming brush list will be freed before exiting
@@ -45,6 +45,8 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 extern	int use_nodequeue;		//brushbsp.c
 extern	int calcgrapplereach;	//be_aas_reach.c
 
+unsigned Com_BlockChecksum(const void *buffer, int length);	//md4.c
+
 float			subdivide_size = 240;
 char			source[1024];
 char			name[1024];
@@ -77,6 +79,19 @@ qboolean	noliquids;			//no liquids when writing map file
 qboolean	forcesidesvisible;	//force all brush sides to be visible when loaded from bsp
 qboolean	capsule_collision = 0;
 
+//manifest entry with the checksums an AAS file was created with
+typedef struct aasmanifest_s
+{
+	char aasfile[MAX_PATH];
+	unsigned bspchecksum;
+	unsigned cfgchecksum;
+	struct aasmanifest_s *next;
+} aasmanifest_t;
+
+char manifestfile[MAX_PATH];		//manifest used to skip up to date AAS files
+char reportfile[MAX_PATH];			//report with the results for every BSP file
+aasmanifest_t *aasmanifest;
+
 /*
 //===========================================================================
 //
@@ -364,6 +379,158 @@ void AASOuputFile(quakefile_t *qf, char *outputpath, char *filename)
 	} //end else
 } //end of the function AASOutputFile
 //===========================================================================
+// the manifest is a text file with a line for every AAS file:
+// <bsp checksum> <cfg checksum> <aas file>
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+void LoadAASManifest(char *filename)
+{
+	FILE *fp;
+	char buf[1024];
+	aasmanifest_t *entry;
+
+	fp = fopen(filename, "r");
+	if (!fp) return;
+	while(fgets(buf, sizeof(buf), fp))
+	{
+		entry = (aasmanifest_t *) GetClearedMemory(sizeof(aasmanifest_t));
+		if (sscanf(buf, "%u %u %[^\r\n]", &entry->bspchecksum, &entry->cfgchecksum, entry->aasfile) != 3)
+		{
+			FreeMemory(entry);
+			continue;
+		} //end if
+		entry->next = aasmanifest;
+		aasmanifest = entry;
+	} //end while
+	fclose(fp);
+} //end of the function LoadAASManifest
+//===========================================================================
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+void WriteAASManifest(char *filename)
+{
+	FILE *fp;
+	aasmanifest_t *entry;
+
+	fp = fopen(filename, "w");
+	if (!fp)
+	{
+		Warning("can't write manifest %s\n", filename);
+		return;
+	} //end if
+	for (entry = aasmanifest; entry; entry = entry->next)
+	{
+		fprintf(fp, "%u %u %s\n", entry->bspchecksum, entry->cfgchecksum, entry->aasfile);
+	} //end for
+	fclose(fp);
+} //end of the function WriteAASManifest
+//===========================================================================
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+aasmanifest_t *AASManifestEntry(char *aasfile, qboolean create)
+{
+	aasmanifest_t *entry;
+
+	for (entry = aasmanifest; entry; entry = entry->next)
+	{
+		if (!stricmp(entry->aasfile, aasfile)) return entry;
+	} //end for
+	if (!create) return NULL;
+	entry = (aasmanifest_t *) GetClearedMemory(sizeof(aasmanifest_t));
+	strncpy(entry->aasfile, aasfile, MAX_PATH-1);
+	entry->next = aasmanifest;
+	aasmanifest = entry;
+	return entry;
+} //end of the function AASManifestEntry
+//===========================================================================
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+unsigned BSPFileChecksum(quakefile_t *qf)
+{
+	void *buffer;
+	int length;
+	unsigned checksum;
+
+	length = LoadQuakeFile(qf, &buffer);
+	checksum = Com_BlockChecksum(buffer, length);
+	FreeMemory(buffer);
+	return checksum;
+} //end of the function BSPFileChecksum
+//===========================================================================
+// checksum of the cfg and the switches that change the created AAS file
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+unsigned AASCfgChecksum(void)
+{
+	struct
+	{
+		cfg_t cfg;
+		int switches[8];
+	} settings;
+
+	memset(&settings, 0, sizeof(settings));
+	memcpy(&settings.cfg, &cfg, sizeof(cfg_t));
+	settings.switches[0] = optimize;
+	settings.switches[1] = nocsg;
+	settings.switches[2] = nobrushmerge;
+	settings.switches[3] = forcesidesvisible;
+	settings.switches[4] = capsule_collision;
+	settings.switches[5] = calcgrapplereach;
+	settings.switches[6] = use_nodequeue;
+	return Com_BlockChecksum(&settings, sizeof(settings));
+} //end of the function AASCfgChecksum
+//===========================================================================
+// appends a line to the report, the report is a tab separated file
+// with a header line
+//
+// Parameter:			-
+// Returns:				-
+// Changes Globals:		-
+//===========================================================================
+void AASReport(quakefile_t *qf, char *aasfile, char *status, double seconds, qboolean counts)
+{
+	FILE *fp;
+	qboolean header;
+
+	if (!strlen(reportfile)) return;
+	header = access(reportfile, 0x04) != 0;
+	fp = fopen(reportfile, "a");
+	if (!fp)
+	{
+		Warning("can't write report %s\n", reportfile);
+		return;
+	} //end if
+	if (header)
+	{
+		fprintf(fp, "bsp\taas\tstatus\tseconds\tareas\treachabilities\tclusters\n");
+	} //end if
+	if (counts)
+	{
+		fprintf(fp, "%s\t%s\t%s\t%1.1f\t%d\t%d\t%d\n", qf->origname, aasfile, status, seconds,
+						aasworld.numareas, aasworld.reachabilitysize, aasworld.numclusters);
+	} //end if
+	else
+	{
+		fprintf(fp, "%s\t%s\t%s\t%1.1f\t\t\t\n", qf->origname, aasfile, status, seconds);
+	} //end else
+	fclose(fp);
+} //end of the function AASReport
+//===========================================================================
 //
 // Parameter:			-
 // Returns:				-
@@ -507,7 +674,9 @@ int main (int argc, char **argv)
 	char outputpath[MAX_PATH] = "";
 	char filename[MAX_PATH] = "unknown";
 	quakefile_t *qfiles, *qf;
-	double start_time;
+	double start_time, map_time;
+	unsigned bspchecksum = 0, cfgchecksum = 0;
+	aasmanifest_t *entry;
 
 	myargc = argc;
 	myargv = argv;
@@ -661,6 +830,18 @@ int main (int argc, char **argv)
 			if (access(argv[i+1], 0x04)) Warning("the folder %s does not exist", argv[i+1]);
 			strcpy(outputpath, argv[++i]);
 		} //end else if
+		else if (!stricmp(argv[i], "-manifest"))
+		{
+			if (i + 1 >= argc) {i = 0; break;}
+			strcpy(manifestfile, argv[++i]);
+			Log_Print("manifest = %s\n", manifestfile);
+		} //end else if
+		else if (!stricmp(argv[i], "-report"))
+		{
+			if (i + 1 >= argc) {i = 0; break;}
+			strcpy(reportfile, argv[++i]);
+			Log_Print("report = %s\n", reportfile);
+		} //end else if
 		else if (!stricmp(argv[i], "-breadthfirst"))
 		{
 			use_nodequeue = true;
@@ -756,12 +937,31 @@ int main (int argc, char **argv)
 			case COMP_BSP2AAS:
 			{
 				if (!qfiles) Log_Print("no files found\n");
+				if (strlen(manifestfile))
+				{
+					LoadAASManifest(manifestfile);
+					cfgchecksum = AASCfgChecksum();
+				} //end if
 				for (qf = qfiles; qf; qf = qf->next)
 				{
 					AASOuputFile(qf, outputpath, filename);
 					//
 					Log_Print("bsp2aas: %s to %s\n", qf->origname, filename);
 					if (qf->type != QFILETYPE_BSP) Warning("%s is probably not a BSP file\n", qf->origname);
+					map_time = I_FloatTime();
+					//skip the BSP file if the AAS file is up to date
+					if (strlen(manifestfile))
+					{
+						bspchecksum = BSPFileChecksum(qf);
+						entry = AASManifestEntry(filename, false);
+						if (entry && entry->bspchecksum == bspchecksum &&
+								entry->cfgchecksum == cfgchecksum && !access(filename, 0x04))
+						{
+							Log_Print("%s is up to date\n", filename);
+							AASReport(qf, filename, "skipped", I_FloatTime() - map_time, false);
+							continue;
+						} //end if
+					} //end if
 					//set before map loading
 					create_aas = 1;
 					LoadMapFromBSP(qf);
@@ -777,6 +977,15 @@ int main (int argc, char **argv)
 					{
 						Error("error writing %s\n", filename);
 					} //end if
+					AASReport(qf, filename, "created", I_FloatTime() - map_time, true);
+					//remember the checksums the AAS file was created with
+					if (strlen(manifestfile))
+					{
+						entry = AASManifestEntry(filename, true);
+						entry->bspchecksum = bspchecksum;
+						entry->cfgchecksum = cfgchecksum;
+						WriteAASManifest(manifestfile);
+					} //end if
 					//deallocate memory
 					AAS_FreeMaxAAS();
 				} //end for
@@ -951,6 +1160,8 @@ int main (int argc, char **argv)
 			"   aasopt   <filter.aas>                = optimize aas file\n"
 			"   aasinfo  <filter.aas>                = show AAS file info\n"
 			"   output   <output path>               = set output path\n"
+			"   manifest <filename>                  = skip up to date AAS files\n"
+			"   report   <filename>                  = write a report for all BSP files\n"
 			"   threads  <X>                         = set number of threads to X\n"
 			"   cfg      <filename>                  = use this cfg file\n"
 			"   optimize                             = enable optimization\n"
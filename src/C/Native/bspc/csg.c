@@ -33,6 +33,28 @@ there will be no brush overlap after csg phase
 int minplanenums[3];
 int maxplanenums[3];
 
+#define CSGGRID_MAXCELLS		64		//maximum number of cells along an axis
+#define CSGGRID_MINCELLSIZE		128		//minimum size of a grid cell
+
+//x-y grid with the brushes of the csg brush list
+typedef struct csggrid_s
+{
+	float origin[2];				//lower corner of the grid
+	float cellsize;					//size of a grid cell
+	int size[2];					//number of cells along the x and y axis
+	int numbrushes;					//number of brushes in the list
+	bspbrush_t **brushes;			//brushes in list order
+	int maxbrushes;					//number of brushes allocated
+	int cellfirst[CSGGRID_MAXCELLS * CSGGRID_MAXCELLS + 1];	//first index in cellbrushes for every cell
+	int *cellbrushes;				//brushes in every cell sorted on list order
+	int maxcellbrushes;				//number of cell brushes allocated
+	int *brushstamp;				//stamp used to collect every brush only once
+	int stamp;
+	int *candidates;				//brushes that might intersect a brush
+} csggrid_t;
+
+csggrid_t csggrid;
+
 //===========================================================================
 //
 // Parameter:				-
@@ -727,6 +749,183 @@ qboolean BrushGE (bspbrush_t *b1, bspbrush_t *b2)
 	return false;
 } //end of the function BrushGE
 //===========================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+void CSG_GridCells(bspbrush_t *brush, int cellmins[2], int cellmaxs[2])
+{
+	int i;
+
+	for (i = 0; i < 2; i++)
+	{
+		cellmins[i] = (int) ((brush->mins[i] - csggrid.origin[i]) / csggrid.cellsize);
+		cellmaxs[i] = (int) ((brush->maxs[i] - csggrid.origin[i]) / csggrid.cellsize);
+		if (cellmins[i] < 0) cellmins[i] = 0;
+		if (cellmaxs[i] >= csggrid.size[i]) cellmaxs[i] = csggrid.size[i] - 1;
+	} //end for
+} //end of the function CSG_GridCells
+//===========================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+void CSG_FreeGrid(void)
+{
+	if (csggrid.brushes) FreeMemory(csggrid.brushes);
+	if (csggrid.brushstamp) FreeMemory(csggrid.brushstamp);
+	if (csggrid.candidates) FreeMemory(csggrid.candidates);
+	if (csggrid.cellbrushes) FreeMemory(csggrid.cellbrushes);
+	memset(&csggrid, 0, sizeof(csggrid_t));
+} //end of the function CSG_FreeGrid
+//===========================================================================
+// puts the brushes of the list in an x-y grid, brushes can only
+// intersect when they share a grid cell
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+void CSG_BuildGrid(bspbrush_t *list)
+{
+	int i, x, y, cell, numcellbrushes;
+	int cellmins[2], cellmaxs[2];
+	float mins[2], maxs[2], size;
+	bspbrush_t *b;
+
+	csggrid.numbrushes = 0;
+	for (b = list; b; b = b->next)
+	{
+		if (!csggrid.numbrushes)
+		{
+			mins[0] = b->mins[0]; mins[1] = b->mins[1];
+			maxs[0] = b->maxs[0]; maxs[1] = b->maxs[1];
+		} //end if
+		for (i = 0; i < 2; i++)
+		{
+			if (b->mins[i] < mins[i]) mins[i] = b->mins[i];
+			if (b->maxs[i] > maxs[i]) maxs[i] = b->maxs[i];
+		} //end for
+		csggrid.numbrushes++;
+	} //end for
+	if (!csggrid.numbrushes) return;
+	//
+	if (csggrid.numbrushes > csggrid.maxbrushes)
+	{
+		if (csggrid.brushes) FreeMemory(csggrid.brushes);
+		if (csggrid.brushstamp) FreeMemory(csggrid.brushstamp);
+		if (csggrid.candidates) FreeMemory(csggrid.candidates);
+		csggrid.maxbrushes = csggrid.numbrushes * 2;
+		csggrid.brushes = (bspbrush_t **) GetMemory(csggrid.maxbrushes * sizeof(bspbrush_t *));
+		csggrid.brushstamp = (int *) GetMemory(csggrid.maxbrushes * sizeof(int));
+		csggrid.candidates = (int *) GetMemory(csggrid.maxbrushes * sizeof(int));
+	} //end if
+	memset(csggrid.brushstamp, 0, csggrid.numbrushes * sizeof(int));
+	csggrid.stamp = 0;
+	//
+	size = maxs[0] - mins[0];
+	if (maxs[1] - mins[1] > size) size = maxs[1] - mins[1];
+	csggrid.cellsize = size / CSGGRID_MAXCELLS + 1;
+	if (csggrid.cellsize < CSGGRID_MINCELLSIZE) csggrid.cellsize = CSGGRID_MINCELLSIZE;
+	for (i = 0; i < 2; i++)
+	{
+		csggrid.origin[i] = mins[i];
+		csggrid.size[i] = (int) ((maxs[i] - mins[i]) / csggrid.cellsize) + 1;
+		if (csggrid.size[i] > CSGGRID_MAXCELLS) csggrid.size[i] = CSGGRID_MAXCELLS;
+	} //end for
+	//count the brushes in every cell
+	memset(csggrid.cellfirst, 0, sizeof(csggrid.cellfirst));
+	for (i = 0, b = list; b; b = b->next, i++)
+	{
+		csggrid.brushes[i] = b;
+		CSG_GridCells(b, cellmins, cellmaxs);
+		for (x = cellmins[0]; x <= cellmaxs[0]; x++)
+		{
+			for (y = cellmins[1]; y <= cellmaxs[1]; y++)
+			{
+				csggrid.cellfirst[x * csggrid.size[1] + y + 1]++;
+			} //end for
+		} //end for
+	} //end for
+	for (cell = 0; cell < csggrid.size[0] * csggrid.size[1]; cell++)
+	{
+		csggrid.cellfirst[cell + 1] += csggrid.cellfirst[cell];
+	} //end for
+	numcellbrushes = csggrid.cellfirst[csggrid.size[0] * csggrid.size[1]];
+	if (numcellbrushes > csggrid.maxcellbrushes)
+	{
+		if (csggrid.cellbrushes) FreeMemory(csggrid.cellbrushes);
+		csggrid.maxcellbrushes = numcellbrushes * 2;
+		csggrid.cellbrushes = (int *) GetMemory(csggrid.maxcellbrushes * sizeof(int));
+	} //end if
+	//fill the cells in list order, the cellfirst of every cell is advanced
+	//to the start of the next cell while filling
+	for (i = 0; i < csggrid.numbrushes; i++)
+	{
+		CSG_GridCells(csggrid.brushes[i], cellmins, cellmaxs);
+		for (x = cellmins[0]; x <= cellmaxs[0]; x++)
+		{
+			for (y = cellmins[1]; y <= cellmaxs[1]; y++)
+			{
+				cell = x * csggrid.size[1] + y;
+				csggrid.cellbrushes[csggrid.cellfirst[cell]++] = i;
+			} //end for
+		} //end for
+	} //end for
+	//shift the cell starts back
+	for (cell = csggrid.size[0] * csggrid.size[1]; cell > 0; cell--)
+	{
+		csggrid.cellfirst[cell] = csggrid.cellfirst[cell - 1];
+	} //end for
+	csggrid.cellfirst[0] = 0;
+} //end of the function CSG_BuildGrid
+//===========================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+int CSG_CompareBrushNums(const void *a, const void *b)
+{
+	return *(int *) a - *(int *) b;
+} //end of the function CSG_CompareBrushNums
+//===========================================================================
+// collects the brushes after the given brush in the list that share a
+// grid cell with the brush, the brushes are sorted on list order
+//
+// Parameter:				-
+// Returns:					number of candidates in csggrid.candidates
+// Changes Globals:		-
+//===========================================================================
+int CSG_GridCandidates(int brushnum)
+{
+	int x, y, i, n, cell, numcandidates;
+	int cellmins[2], cellmaxs[2];
+
+	csggrid.stamp++;
+	numcandidates = 0;
+	CSG_GridCells(csggrid.brushes[brushnum], cellmins, cellmaxs);
+	for (x = cellmins[0]; x <= cellmaxs[0]; x++)
+	{
+		for (y = cellmins[1]; y <= cellmaxs[1]; y++)
+		{
+			cell = x * csggrid.size[1] + y;
+			for (i = csggrid.cellfirst[cell]; i < csggrid.cellfirst[cell + 1]; i++)
+			{
+				n = csggrid.cellbrushes[i];
+				if (n <= brushnum) continue;
+				if (csggrid.brushstamp[n] == csggrid.stamp) continue;
+				csggrid.brushstamp[n] = csggrid.stamp;
+				csggrid.candidates[numcandidates++] = n;
+			} //end for
+		} //end for
+	} //end for
+	qsort(csggrid.candidates, numcandidates, sizeof(int), CSG_CompareBrushNums);
+	return numcandidates;
+} //end of the function CSG_GridCandidates
+//===========================================================================
 // Carves any intersecting solid brushes into the minimum number
 // of non-intersecting brushes.
 //
@@ -742,6 +941,7 @@ bspbrush_t *ChopBrushes (bspbrush_t *head)
 	bspbrush_t	*sub, *sub2;
 	int			c1, c2;
 	int num_csg_iterations;
+	int			b1num, numcandidates, i;
 
 	Log_Print("-------- Brush CSG ---------\n");
 	Log_Print("%6d original brushes\n", CountBrushList (head));
@@ -761,8 +961,10 @@ newlist:
 
 	for (tail = head; tail->next; tail = tail->next)
 		;
+	//only brushes sharing a grid cell can intersect
+	CSG_BuildGrid(head);
 
-	for (b1=head ; b1 ; b1=next)
+	for (b1=head, b1num = 0; b1 ; b1=next, b1num++)
 	{
 		next = b1->next;
 
@@ -774,8 +976,10 @@ newlist:
 			continue;
 		} //end if
 		
-		for (b2 = b1->next; b2; b2 = b2->next)
+		numcandidates = CSG_GridCandidates(b1num);
+		for (i = 0; i < numcandidates; i++)
 		{
+			b2 = csggrid.brushes[csggrid.candidates[i]];
 			if (BrushesDisjoint (b1, b2))
 				continue;
 
@@ -843,7 +1047,7 @@ newlist:
 			} //end else
 		} //end for
 
-		if (!b2)
+		if (i >= numcandidates)
 		{	// b1 is no longer intersecting anything, so keep it
 			b1->next = keep;
 			keep = b1;
@@ -852,6 +1056,8 @@ newlist:
 		qprintf("\r%6d", num_csg_iterations);
 	} //end for
 
+	CSG_FreeGrid();
+
 	if (cancelconversion) return keep;
 	//
 	qprintf("\n");
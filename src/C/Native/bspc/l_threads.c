@@ -35,6 +35,8 @@ int oldf;
 qboolean pacifier;
 qboolean	threaded;
 void (*workfunction) (int);
+int workchunksize;
+void (*chunkfunction) (int start, int end);
 
 //===========================================================================
 //
@@ -101,6 +103,89 @@ void RunThreadsOnIndividual (int workcnt, qboolean showpacifier, void(*func)(int
 	workfunction = func;
 	RunThreadsOn (workcnt, showpacifier, ThreadWorkerFunction);
 } //end of the function RunThreadsOnIndividual
+//===========================================================================
+// returns the first work item of the next chunk of work or -1 when
+// all work is dispatched, end is set to one past the last work item
+// of the chunk
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+int GetThreadWorkChunk(int *end)
+{
+	int	r;
+	int	f;
+
+	ThreadLock();
+
+	if (dispatch == workcount)
+	{
+		ThreadUnlock ();
+		return -1;
+	} //end if
+
+	f = 10*dispatch / workcount;
+	if (f != oldf)
+	{
+		oldf = f;
+		if (pacifier)
+			printf ("%i...", f);
+	} //end if
+
+	r = dispatch;
+	dispatch += workchunksize;
+	if (dispatch > workcount) dispatch = workcount;
+	*end = dispatch;
+	ThreadUnlock ();
+
+	return r;
+} //end of the function GetThreadWorkChunk
+//===========================================================================
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+void ThreadChunkWorkerFunction(int threadnum)
+{
+	int		start, end;
+
+	while(1)
+	{
+		start = GetThreadWorkChunk (&end);
+		if (start == -1)
+			break;
+		chunkfunction(start, end);
+	} //end while
+} //end of the function ThreadChunkWorkerFunction
+//===========================================================================
+// runs func over the work items [0, workcnt) handing out chunks of
+// chunksize work items at once to keep the locking overhead down for
+// small work items
+//
+// Parameter:				-
+// Returns:					-
+// Changes Globals:		-
+//===========================================================================
+void RunThreadsOnChunked(int workcnt, int chunksize, qboolean showpacifier, void(*func)(int, int))
+{
+	if (workcnt <= 0)
+		return;
+	if (numthreads == -1)
+		ThreadSetDefault ();
+	//without threads just do all the work at once
+	if (numthreads <= 1)
+	{
+		func(0, workcnt);
+		return;
+	} //end if
+	if (chunksize < 1)
+		chunksize = 1;
+	workchunksize = chunksize;
+	chunkfunction = func;
+	RunThreadsOn (workcnt, showpacifier, ThreadChunkWorkerFunction);
+} //end of the function RunThreadsOnChunked
 
 
 //===================================================================
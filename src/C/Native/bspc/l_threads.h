@@ -26,6 +26,7 @@ void ThreadSetDefault (void);
 int GetThreadWork (void);
 void RunThreadsOnIndividual (int workcnt, qboolean showpacifier, void(*func)(int));
 void RunThreadsOn (int workcnt, qboolean showpacifier, void(*func)(int));
+void RunThreadsOnChunked(int workcnt, int chunksize, qboolean showpacifier, void(*func)(int, int));
 
 //mutex
 void ThreadSetupLock(void);
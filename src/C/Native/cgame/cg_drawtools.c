@@ -151,6 +151,29 @@ void CG_DrawChar( int x, int y, int width, int height, int ch ) {
 }
 
 
+/*
+===============
+CG_DrawCharRun
+
+Draws a run of characters without color escapes as a single render command
+===============
+*/
+static void CG_DrawCharRun( int x, int y, int width, int height, const char *run, int len ) {
+	float	ax, ay, aw, ah;
+
+	if ( len <= 0 ) {
+		return;
+	}
+
+	ax = x;
+	ay = y;
+	aw = width;
+	ah = height;
+	CG_AdjustFrom640( &ax, &ay, &aw, &ah );
+
+	trap_R_DrawString( ax, ay, aw, ah, run, len, cgs.media.charsetShader );
+}
+
 /*
 ==================
 CG_DrawStringExt
@@ -167,6 +190,8 @@ void CG_DrawStringExt( int x, int y, const char *string, const float *setColor,
 	const char	*s;
 	int			xx;
 	int			cnt;
+	char		run[256];
+	int			runX, len;
 
 	if (maxChars <= 0)
 		maxChars = 32767; // do them all!
@@ -179,26 +204,39 @@ void CG_DrawStringExt( int x, int y, const char *string, const float *setColor,
 		s = string;
 		xx = x;
 		cnt = 0;
+		runX = xx;
+		len = 0;
 		while ( *s && cnt < maxChars) {
 			if ( Q_IsColorString( s ) ) {
 				s += 2;
 				continue;
 			}
-			CG_DrawChar( xx + 2, y + 2, charWidth, charHeight, *s );
+			if ( len == sizeof( run ) ) {
+				CG_DrawCharRun( runX + 2, y + 2, charWidth, charHeight, run, len );
+				runX = xx;
+				len = 0;
+			}
+			run[len++] = *s;
 			cnt++;
 			xx += charWidth;
 			s++;
 		}
+		CG_DrawCharRun( runX + 2, y + 2, charWidth, charHeight, run, len );
 	}
 
 	// draw the colored text
 	s = string;
 	xx = x;
 	cnt = 0;
+	runX = xx;
+	len = 0;
 	trap_R_SetColor( setColor );
 	while ( *s && cnt < maxChars) {
 		if ( Q_IsColorString( s ) ) {
 			if ( !forceColor ) {
+				CG_DrawCharRun( runX, y, charWidth, charHeight, run, len );
+				runX = xx;
+				len = 0;
 				memcpy( color, g_color_table[ColorIndex(*(s+1))], sizeof( color ) );
 				color[3] = setColor[3];
 				trap_R_SetColor( color );
@@ -206,11 +244,17 @@ void CG_DrawStringExt( int x, int y, const char *string, const float *setColor,
 			s += 2;
 			continue;
 		}
-		CG_DrawChar( xx, y, charWidth, charHeight, *s );
+		if ( len == sizeof( run ) ) {
+			CG_DrawCharRun( runX, y, charWidth, charHeight, run, len );
+			runX = xx;
+			len = 0;
+		}
+		run[len++] = *s;
 		xx += charWidth;
 		cnt++;
 		s++;
 	}
+	CG_DrawCharRun( runX, y, charWidth, charHeight, run, len );
 	trap_R_SetColor( NULL );
 }
 
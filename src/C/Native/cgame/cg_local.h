@@ -1583,6 +1583,10 @@ void		trap_R_RenderScene( const refdef_t *fd );
 void		trap_R_SetColor( const float *rgba );	// NULL = 1,1,1,1
 void		trap_R_DrawStretchPic( float x, float y, float w, float h, 
 			float s1, float t1, float s2, float t2, qhandle_t hShader );
+void		trap_R_DrawString( float x, float y, float w, float h, 
+			const char *string, int numChars, qhandle_t hShader );
+void		trap_R_DrawGlyphString( float x, float y, float xScale, float yScale, float adjust, 
+			const fontInfo_t *font, const char *string, int numChars );
 void		trap_R_ModelBounds( clipHandle_t model, vec3_t mins, vec3_t maxs );
 int			trap_R_LerpTag( orientation_t *tag, clipHandle_t mod, int startFrame, int endFrame, 
 					   float frac, const char *tagName );
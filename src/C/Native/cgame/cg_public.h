@@ -163,6 +163,8 @@ typedef enum {
 	CG_R_INPVS,
 	// 1.32
 	CG_FS_SEEK,
+	CG_R_DRAWSTRING,
+	CG_R_DRAWGLYPHSTRING,
 
 /*
 	CG_LOADCAMERA,
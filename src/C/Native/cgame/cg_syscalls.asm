@@ -90,6 +90,8 @@ equ trap_GetEntityToken					-87
 equ	trap_R_AddPolysToScene				-88
 equ trap_R_inPVS						-89
 equ trap_FS_Seek			-90
+equ trap_R_DrawString		-91
+equ trap_R_DrawGlyphString	-92
 
 equ	memset						-101
 equ	memcpy						-102
@@ -288,6 +288,16 @@ void	trap_R_DrawStretchPic( float x, float y, float w, float h,
 	syscall( CG_R_DRAWSTRETCHPIC, PASSFLOAT(x), PASSFLOAT(y), PASSFLOAT(w), PASSFLOAT(h), PASSFLOAT(s1), PASSFLOAT(t1), PASSFLOAT(s2), PASSFLOAT(t2), hShader );
 }
 
+void	trap_R_DrawString( float x, float y, float w, float h, 
+						   const char *string, int numChars, qhandle_t hShader ) {
+	syscall( CG_R_DRAWSTRING, PASSFLOAT(x), PASSFLOAT(y), PASSFLOAT(w), PASSFLOAT(h), string, numChars, hShader );
+}
+
+void	trap_R_DrawGlyphString( float x, float y, float xScale, float yScale, float adjust, 
+								const fontInfo_t *font, const char *string, int numChars ) {
+	syscall( CG_R_DRAWGLYPHSTRING, PASSFLOAT(x), PASSFLOAT(y), PASSFLOAT(xScale), PASSFLOAT(yScale), PASSFLOAT(adjust), font, string, numChars );
+}
+
 void	trap_R_ModelBounds( clipHandle_t model, vec3_t mins, vec3_t maxs ) {
 	syscall( CG_R_MODELBOUNDS, model, mins, maxs );
 }
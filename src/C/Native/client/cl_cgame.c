@@ -577,6 +577,12 @@ int CL_CgameSystemCalls( int *args ) {
 	case CG_R_DRAWSTRETCHPIC:
 		re.DrawStretchPic( VMF(1), VMF(2), VMF(3), VMF(4), VMF(5), VMF(6), VMF(7), VMF(8), args[9] );
 		return 0;
+	case CG_R_DRAWSTRING:
+		re.DrawString( VMF(1), VMF(2), VMF(3), VMF(4), VMA(5), args[6], args[7] );
+		return 0;
+	case CG_R_DRAWGLYPHSTRING:
+		re.DrawGlyphString( VMF(1), VMF(2), VMF(3), VMF(4), VMF(5), VMA(6), VMA(7), args[8] );
+		return 0;
 	case CG_R_MODELBOUNDS:
 		re.ModelBounds( args[1], VMA(2), VMA(3) );
 		return 0;
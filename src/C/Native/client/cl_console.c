@@ -492,6 +492,52 @@ void Con_DrawInput (void) {
 }
 
 
+/*
+================
+Con_DrawTextLine
+
+Draws one console line as runs of same colored characters
+================
+*/
+static void Con_DrawTextLine( int x, int y, const short *text, int *currentColor ) {
+	char	run[MAX_STRING_CHARS];
+	int		i, ch, color;
+	int		runStart, len, drawLen;
+
+	runStart = 0;
+	len = 0;
+	drawLen = 0;
+	for ( i = 0 ; i < con.linewidth ; i++ ) {
+		ch = text[i] & 0xff;
+		if ( ch == ' ' ) {
+			// spaces never change the color, keep them inside the run
+			if ( len && len < sizeof( run ) ) {
+				run[len++] = ' ';
+			}
+			continue;
+		}
+
+		color = ( text[i] >> 8 ) & 7;
+		if ( color != *currentColor || len == sizeof( run ) ) {
+			SCR_DrawSmallCharRun( x + runStart * SMALLCHAR_WIDTH, y, run, drawLen );
+			len = 0;
+			drawLen = 0;
+			if ( color != *currentColor ) {
+				*currentColor = color;
+				re.SetColor( g_color_table[color] );
+			}
+		}
+
+		if ( !len ) {
+			runStart = i;
+		}
+		run[len++] = ch;
+		drawLen = len;
+	}
+
+	SCR_DrawSmallCharRun( x + runStart * SMALLCHAR_WIDTH, y, run, drawLen );
+}
+
 /*
 ================
 Con_DrawNotify
@@ -501,7 +547,7 @@ Draws the last few lines of output transparently over the game top
 */
 void Con_DrawNotify (void)
 {
-	int		x, v;
+	int		v;
 	short	*text;
 	int		i;
 	int		time;
@@ -528,16 +574,7 @@ void Con_DrawNotify (void)
 			continue;
 		}
 
-		for (x = 0 ; x < con.linewidth ; x++) {
-			if ( ( text[x] & 0xff ) == ' ' ) {
-				continue;
-			}
-			if ( ( (text[x]>>8)&7 ) != currentColor ) {
-				currentColor = (text[x]>>8)&7;
-				re.SetColor( g_color_table[currentColor] );
-			}
-			SCR_DrawSmallChar( cl_conXOffset->integer + con.xadjust + (x+1)*SMALLCHAR_WIDTH, v, text[x] & 0xff );
-		}
+		Con_DrawTextLine( cl_conXOffset->integer + con.xadjust + SMALLCHAR_WIDTH, v, text, &currentColor );
 
 		v += SMALLCHAR_HEIGHT;
 	}
@@ -666,17 +703,7 @@ void Con_DrawSolidConsole( float frac ) {
 
 		text = con.text + (row % con.totallines)*con.linewidth;
 
-		for (x=0 ; x<con.linewidth ; x++) {
-			if ( ( text[x] & 0xff ) == ' ' ) {
-				continue;
-			}
-
-			if ( ( (text[x]>>8)&7 ) != currentColor ) {
-				currentColor = (text[x]>>8)&7;
-				re.SetColor( g_color_table[currentColor] );
-			}
-			SCR_DrawSmallChar(  con.xadjust + (x+1)*SMALLCHAR_WIDTH, y, text[x] & 0xff );
-		}
+		Con_DrawTextLine( con.xadjust + SMALLCHAR_WIDTH, y, text, &currentColor );
 	}
 
 	// draw the input prompt, user text, and cursor if desired
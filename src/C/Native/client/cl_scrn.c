@@ -116,13 +116,13 @@ void SCR_DrawPic( float x, float y, float width, float height, qhandle_t hShader
 
 
 /*
-** SCR_DrawChar
-** chars are drawn at 640*480 virtual screen size
+** SCR_DrawSmallChar
+** small chars are drawn at native screen resolution
 */
-static void SCR_DrawChar( int x, int y, float size, int ch ) {
+void SCR_DrawSmallChar( int x, int y, int ch ) {
 	int row, col;
 	float frow, fcol;
-	float	ax, ay, aw, ah;
+	float size;
 
 	ch &= 255;
 
@@ -130,16 +130,10 @@ static void SCR_DrawChar( int x, int y, float size, int ch ) {
 		return;
 	}
 
-	if ( y < -size ) {
+	if ( y < -SMALLCHAR_HEIGHT ) {
 		return;
 	}
 
-	ax = x;
-	ay = y;
-	aw = size;
-	ah = size;
-	SCR_AdjustFrom640( &ax, &ay, &aw, &ah );
-
 	row = ch>>4;
 	col = ch&15;
 
@@ -147,44 +141,52 @@ static void SCR_DrawChar( int x, int y, float size, int ch ) {
 	fcol = col*0.0625;
 	size = 0.0625;
 
-	re.DrawStretchPic( ax, ay, aw, ah,
+	re.DrawStretchPic( x, y, SMALLCHAR_WIDTH, SMALLCHAR_HEIGHT,
 					   fcol, frow, 
 					   fcol + size, frow + size, 
 					   cls.charSetShader );
 }
 
+
 /*
-** SCR_DrawSmallChar
-** small chars are drawn at native screen resolution
+** SCR_DrawCharRun
+** a run of chars without color escapes, drawn at 640*480 virtual screen size
 */
-void SCR_DrawSmallChar( int x, int y, int ch ) {
-	int row, col;
-	float frow, fcol;
-	float size;
-
-	ch &= 255;
+static void SCR_DrawCharRun( int x, int y, float size, const char *run, int len ) {
+	float	ax, ay, aw, ah;
 
-	if ( ch == ' ' ) {
+	if ( len <= 0 ) {
 		return;
 	}
 
-	if ( y < -SMALLCHAR_HEIGHT ) {
+	if ( y < -size ) {
 		return;
 	}
 
-	row = ch>>4;
-	col = ch&15;
-
-	frow = row*0.0625;
-	fcol = col*0.0625;
-	size = 0.0625;
+	ax = x;
+	ay = y;
+	aw = size;
+	ah = size;
+	SCR_AdjustFrom640( &ax, &ay, &aw, &ah );
 
-	re.DrawStretchPic( x, y, SMALLCHAR_WIDTH, SMALLCHAR_HEIGHT,
-					   fcol, frow, 
-					   fcol + size, frow + size, 
-					   cls.charSetShader );
+	re.DrawString( ax, ay, aw, ah, run, len, cls.charSetShader );
 }
 
+/*
+** SCR_DrawSmallCharRun
+** a run of small chars without color escapes, drawn at native screen resolution
+*/
+void SCR_DrawSmallCharRun( int x, int y, const char *run, int len ) {
+	if ( len <= 0 ) {
+		return;
+	}
+
+	if ( y < -SMALLCHAR_HEIGHT ) {
+		return;
+	}
+
+	re.DrawString( x, y, SMALLCHAR_WIDTH, SMALLCHAR_HEIGHT, run, len, cls.charSetShader );
+}
 
 /*
 ==================
@@ -200,6 +202,12 @@ void SCR_DrawStringExt( int x, int y, float size, const char *string, float *set
 	vec4_t		color;
 	const char	*s;
 	int			xx;
+	char		run[256];
+	int			runX, len, maxLen;
+
+	// characters are advanced by a truncated integer step, so only an
+	// integer size lets a run place them at the same positions
+	maxLen = ( size == (int)size ) ? sizeof( run ) : 1;
 
 	// draw the drop shadow
 	color[0] = color[1] = color[2] = 0;
@@ -207,24 +215,37 @@ void SCR_DrawStringExt( int x, int y, float size, const char *string, float *set
 	re.SetColor( color );
 	s = string;
 	xx = x;
+	runX = xx;
+	len = 0;
 	while ( *s ) {
 		if ( Q_IsColorString( s ) ) {
 			s += 2;
 			continue;
 		}
-		SCR_DrawChar( xx+2, y+2, size, *s );
+		if ( len == maxLen ) {
+			SCR_DrawCharRun( runX+2, y+2, size, run, len );
+			runX = xx;
+			len = 0;
+		}
+		run[len++] = *s;
 		xx += size;
 		s++;
 	}
+	SCR_DrawCharRun( runX+2, y+2, size, run, len );
 
 
 	// draw the colored text
 	s = string;
 	xx = x;
+	runX = xx;
+	len = 0;
 	re.SetColor( setColor );
 	while ( *s ) {
 		if ( Q_IsColorString( s ) ) {
 			if ( !forceColor ) {
+				SCR_DrawCharRun( runX, y, size, run, len );
+				runX = xx;
+				len = 0;
 				Com_Memcpy( color, g_color_table[ColorIndex(*(s+1))], sizeof( color ) );
 				color[3] = setColor[3];
 				re.SetColor( color );
@@ -232,10 +253,16 @@ void SCR_DrawStringExt( int x, int y, float size, const char *string, float *set
 			s += 2;
 			continue;
 		}
-		SCR_DrawChar( xx, y, size, *s );
+		if ( len == maxLen ) {
+			SCR_DrawCharRun( runX, y, size, run, len );
+			runX = xx;
+			len = 0;
+		}
+		run[len++] = *s;
 		xx += size;
 		s++;
 	}
+	SCR_DrawCharRun( runX, y, size, run, len );
 	re.SetColor( NULL );
 }
 
@@ -267,14 +294,21 @@ void SCR_DrawSmallStringExt( int x, int y, const char *string, float *setColor,
 	vec4_t		color;
 	const char	*s;
 	int			xx;
+	char		run[256];
+	int			runX, len;
 
 	// draw the colored text
 	s = string;
 	xx = x;
+	runX = xx;
+	len = 0;
 	re.SetColor( setColor );
 	while ( *s ) {
 		if ( Q_IsColorString( s ) ) {
 			if ( !forceColor ) {
+				SCR_DrawSmallCharRun( runX, y, run, len );
+				runX = xx;
+				len = 0;
 				Com_Memcpy( color, g_color_table[ColorIndex(*(s+1))], sizeof( color ) );
 				color[3] = setColor[3];
 				re.SetColor( color );
@@ -282,10 +316,16 @@ void SCR_DrawSmallStringExt( int x, int y, const char *string, float *setColor,
 			s += 2;
 			continue;
 		}
-		SCR_DrawSmallChar( xx, y, *s );
+		if ( len == sizeof( run ) ) {
+			SCR_DrawSmallCharRun( runX, y, run, len );
+			runX = xx;
+			len = 0;
+		}
+		run[len++] = *s;
 		xx += SMALLCHAR_WIDTH;
 		s++;
 	}
+	SCR_DrawSmallCharRun( runX, y, run, len );
 	re.SetColor( NULL );
 }
 
@@ -1030,6 +1030,10 @@ int CL_UISystemCalls( int *args ) {
 	case UI_SET_PBCLSTATUS:
 		return 0;	
 
+	case UI_R_DRAWGLYPHSTRING:
+		re.DrawGlyphString( VMF(1), VMF(2), VMF(3), VMF(4), VMF(5), VMA(6), VMA(7), args[8] );
+		return 0;
+
 	case UI_R_REGISTERFONT:
 		re.RegisterFont( VMA(1), args[2], VMA(3));
 		return 0;
@@ -470,6 +470,7 @@ void	SCR_DrawBigString( int x, int y, const char *s, float alpha );			// draws a
 void	SCR_DrawBigStringColor( int x, int y, const char *s, vec4_t color );	// ignores embedded color control characters
 void	SCR_DrawSmallStringExt( int x, int y, const char *string, float *setColor, qboolean forceColor );
 void	SCR_DrawSmallChar( int x, int y, int ch );
+void	SCR_DrawSmallCharRun( int x, int y, const char *run, int len );
 
 
 //
@@ -71,7 +71,11 @@ int bot_interbreed;
 int bot_interbreedmatchcount;
 //
 vmCvar_t bot_thinktime;
+vmCvar_t bot_maxthinksperframe;
 vmCvar_t bot_memorydump;
+vmCvar_t bot_benchmarkrouting;
+vmCvar_t bot_routingcachestats;
+vmCvar_t bot_predictionstats;
 vmCvar_t bot_saveroutingcache;
 vmCvar_t bot_pause;
 vmCvar_t bot_report;
@@ -1282,6 +1286,8 @@ int BotAIShutdownClient(int client, qboolean restart) {
 	bs->inuse = qfalse;
 	//there's one bot less
 	numbots--;
+	//spread the remaining bots over the think time again
+	BotScheduleBotThink();
 	//everything went ok
 	return qtrue;
 }
@@ -1377,11 +1383,16 @@ BotAIStartFrame
 int BotAIStartFrame(int time) {
 	int i;
 	gentity_t	*ent;
-	bot_entitystate_t state;
+	bot_entitystate_t *state;
+	int numentities;
+	static int entnums[MAX_GENTITIES];
+	static bot_entitystate_t states[MAX_GENTITIES];
 	int elapsed_time, thinktime;
+	int j, numthinks, nextthinkstart;
 	static int local_time;
 	static int botlib_residual;
 	static int lastbotthink_time;
+	static int botthinkstart;
 
 	G_CheckBotSpawn();
 
@@ -1391,7 +1402,11 @@ int BotAIStartFrame(int time) {
 	trap_Cvar_Update(&bot_nochat);
 	trap_Cvar_Update(&bot_testrchat);
 	trap_Cvar_Update(&bot_thinktime);
+	trap_Cvar_Update(&bot_maxthinksperframe);
 	trap_Cvar_Update(&bot_memorydump);
+	trap_Cvar_Update(&bot_benchmarkrouting);
+	trap_Cvar_Update(&bot_routingcachestats);
+	trap_Cvar_Update(&bot_predictionstats);
 	trap_Cvar_Update(&bot_saveroutingcache);
 	trap_Cvar_Update(&bot_pause);
 	trap_Cvar_Update(&bot_report);
@@ -1425,8 +1440,20 @@ int BotAIStartFrame(int time) {
 		trap_BotLibVarSet("memorydump", "1");
 		trap_Cvar_Set("bot_memorydump", "0");
 	}
+	if (bot_benchmarkrouting.integer) {
+		trap_BotLibVarSet("benchmarkrouting", "1");
+		trap_Cvar_Set("bot_benchmarkrouting", "0");
+	}
+	if (bot_routingcachestats.integer) {
+		trap_BotLibVarSet("routingcachestats", "1");
+		trap_Cvar_Set("bot_routingcachestats", "0");
+	}
+	if (bot_predictionstats.integer) {
+		trap_BotLibVarSet("predictionstats", "1");
+		trap_Cvar_Set("bot_predictionstats", "0");
+	}
 	if (bot_saveroutingcache.integer) {
-		trap_BotLibVarSet("saveroutingcache", "1");
+		trap_BotLibVarSet("saveroutingcache", bot_saveroutingcache.string);
 		trap_Cvar_Set("bot_saveroutingcache", "0");
 	}
 	//check if bot interbreeding is activated
@@ -1457,69 +1484,67 @@ int BotAIStartFrame(int time) {
 
 		if (!trap_AAS_Initialized()) return qfalse;
 
-		//update entities in the botlib
+		//update entities in the botlib with a single call, entities
+		//that are not listed are unlinked
+		numentities = 0;
 		for (i = 0; i < MAX_GENTITIES; i++) {
 			ent = &g_entities[i];
 			if (!ent->inuse) {
-				trap_BotLibUpdateEntity(i, NULL);
 				continue;
 			}
 			if (!ent->r.linked) {
-				trap_BotLibUpdateEntity(i, NULL);
 				continue;
 			}
 			if (ent->r.svFlags & SVF_NOCLIENT) {
-				trap_BotLibUpdateEntity(i, NULL);
 				continue;
 			}
 			// do not update missiles
 			if (ent->s.eType == ET_MISSILE && ent->s.weapon != WP_GRAPPLING_HOOK) {
-				trap_BotLibUpdateEntity(i, NULL);
 				continue;
 			}
 			// do not update event only entities
 			if (ent->s.eType > ET_EVENTS) {
-				trap_BotLibUpdateEntity(i, NULL);
 				continue;
 			}
 #ifdef MISSIONPACK
 			// never link prox mine triggers
 			if (ent->r.contents == CONTENTS_TRIGGER) {
 				if (ent->touch == ProximityMine_Trigger) {
-					trap_BotLibUpdateEntity(i, NULL);
 					continue;
 				}
 			}
 #endif
 			//
-			memset(&state, 0, sizeof(bot_entitystate_t));
+			state = &states[numentities];
+			memset(state, 0, sizeof(bot_entitystate_t));
 			//
-			VectorCopy(ent->r.currentOrigin, state.origin);
+			VectorCopy(ent->r.currentOrigin, state->origin);
 			if (i < MAX_CLIENTS) {
-				VectorCopy(ent->s.apos.trBase, state.angles);
+				VectorCopy(ent->s.apos.trBase, state->angles);
 			} else {
-				VectorCopy(ent->r.currentAngles, state.angles);
+				VectorCopy(ent->r.currentAngles, state->angles);
 			}
-			VectorCopy(ent->s.origin2, state.old_origin);
-			VectorCopy(ent->r.mins, state.mins);
-			VectorCopy(ent->r.maxs, state.maxs);
-			state.type = ent->s.eType;
-			state.flags = ent->s.eFlags;
-			if (ent->r.bmodel) state.solid = SOLID_BSP;
-			else state.solid = SOLID_BBOX;
-			state.groundent = ent->s.groundEntityNum;
-			state.modelindex = ent->s.modelindex;
-			state.modelindex2 = ent->s.modelindex2;
-			state.frame = ent->s.frame;
-			state.event = ent->s.event;
-			state.eventParm = ent->s.eventParm;
-			state.powerups = ent->s.powerups;
-			state.legsAnim = ent->s.legsAnim;
-			state.torsoAnim = ent->s.torsoAnim;
-			state.weapon = ent->s.weapon;
+			VectorCopy(ent->s.origin2, state->old_origin);
+			VectorCopy(ent->r.mins, state->mins);
+			VectorCopy(ent->r.maxs, state->maxs);
+			state->type = ent->s.eType;
+			state->flags = ent->s.eFlags;
+			if (ent->r.bmodel) state->solid = SOLID_BSP;
+			else state->solid = SOLID_BBOX;
+			state->groundent = ent->s.groundEntityNum;
+			state->modelindex = ent->s.modelindex;
+			state->modelindex2 = ent->s.modelindex2;
+			state->frame = ent->s.frame;
+			state->event = ent->s.event;
+			state->eventParm = ent->s.eventParm;
+			state->powerups = ent->s.powerups;
+			state->legsAnim = ent->s.legsAnim;
+			state->torsoAnim = ent->s.torsoAnim;
+			state->weapon = ent->s.weapon;
 			//
-			trap_BotLibUpdateEntity(i, &state);
+			entnums[numentities++] = i;
 		}
+		trap_BotLibUpdateEntities(numentities, entnums, states);
 
 		BotAIRegularUpdate();
 	}
@@ -1527,7 +1552,10 @@ int BotAIStartFrame(int time) {
 	floattime = trap_AAS_Time();
 
 	// execute scheduled bot AI
-	for( i = 0; i < MAX_CLIENTS; i++ ) {
+	numthinks = 0;
+	nextthinkstart = botthinkstart;
+	for( j = 0; j < MAX_CLIENTS; j++ ) {
+		i = (botthinkstart + j) % MAX_CLIENTS;
 		if( !botstates[i] || !botstates[i]->inuse ) {
 			continue;
 		}
@@ -1535,6 +1563,14 @@ int BotAIStartFrame(int time) {
 		botstates[i]->botthink_residual += elapsed_time;
 		//
 		if ( botstates[i]->botthink_residual >= thinktime ) {
+			// if the think budget for this frame is used up the bot
+			// thinks first thing next frame
+			if ( bot_maxthinksperframe.integer > 0 && numthinks >= bot_maxthinksperframe.integer ) {
+				botstates[i]->botthink_residual = thinktime;
+				continue;
+			}
+			numthinks++;
+			nextthinkstart = (i + 1) % MAX_CLIENTS;
 			botstates[i]->botthink_residual -= thinktime;
 
 			if (!trap_AAS_Initialized()) return qfalse;
@@ -1544,6 +1580,14 @@ int BotAIStartFrame(int time) {
 			}
 		}
 	}
+	// continue with the postponed bots next frame, bots always think
+	// in client order when there's no think budget
+	if ( bot_maxthinksperframe.integer > 0 && numthinks >= bot_maxthinksperframe.integer ) {
+		botthinkstart = nextthinkstart;
+	}
+	else {
+		botthinkstart = 0;
+	}
 
 
 	// execute bot user commands every frame
@@ -1613,6 +1657,9 @@ int BotInitLibrary(void) {
 	//
 	trap_Cvar_VariableStringBuffer("bot_saveroutingcache", buf, sizeof(buf));
 	if (strlen(buf)) trap_BotLibVarSet("saveroutingcache", buf);
+	//
+	trap_Cvar_VariableStringBuffer("bot_checkweights", buf, sizeof(buf));
+	if (strlen(buf)) trap_BotLibVarSet("checkweights", buf);
 	//reload instead of cache bot character files
 	trap_Cvar_VariableStringBuffer("bot_reloadcharacters", buf, sizeof(buf));
 	if (!strlen(buf)) strcpy(buf, "0");
@@ -1643,7 +1690,11 @@ int BotAISetup( int restart ) {
 	int			errnum;
 
 	trap_Cvar_Register(&bot_thinktime, "bot_thinktime", "100", CVAR_CHEAT);
+	trap_Cvar_Register(&bot_maxthinksperframe, "bot_maxthinksperframe", "0", 0);
 	trap_Cvar_Register(&bot_memorydump, "bot_memorydump", "0", CVAR_CHEAT);
+	trap_Cvar_Register(&bot_benchmarkrouting, "bot_benchmarkrouting", "0", CVAR_CHEAT);
+	trap_Cvar_Register(&bot_routingcachestats, "bot_routingcachestats", "0", 0);
+	trap_Cvar_Register(&bot_predictionstats, "bot_predictionstats", "0", 0);
 	trap_Cvar_Register(&bot_saveroutingcache, "bot_saveroutingcache", "0", CVAR_CHEAT);
 	trap_Cvar_Register(&bot_pause, "bot_pause", "0", CVAR_CHEAT);
 	trap_Cvar_Register(&bot_report, "bot_report", "0", CVAR_CHEAT);
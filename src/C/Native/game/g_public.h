@@ -241,6 +241,7 @@ typedef enum {
 	BOTLIB_GET_SNAPSHOT_ENTITY,		// ( int client, int ent );
 	BOTLIB_GET_CONSOLE_MESSAGE,		// ( int client, char *message, int size );
 	BOTLIB_USER_COMMAND,			// ( int client, usercmd_t *ucmd );
+	BOTLIB_UPDATENTITIES,			// ( int numentities, int *entnums, bot_entitystate_t *states );
 
 	BOTLIB_AAS_ENABLE_ROUTING_AREA = 300,
 	BOTLIB_AAS_BBOX_AREAS,
@@ -74,6 +74,7 @@ equ trap_BotLibTest						-209
 equ trap_BotGetSnapshotEntity			-210
 equ trap_BotGetServerCommand		-211
 equ trap_BotUserCommand					-212
+equ trap_BotLibUpdateEntities			-213
 
 
 
@@ -256,6 +256,10 @@ int trap_BotLibUpdateEntity(int ent, void /* struct bot_updateentity_s */ *bue)
 	return syscall( BOTLIB_UPDATENTITY, ent, bue );
 }
 
+int trap_BotLibUpdateEntities(int numentities, int *entnums, void /* struct bot_entitystate_s */ *states) {
+	return syscall( BOTLIB_UPDATENTITIES, numentities, entnums, states );
+}
+
 int trap_BotLibTest(int parm0, char *parm1, vec3_t parm2, vec3_t parm3) {
 	return syscall( BOTLIB_TEST, parm0, parm1, parm2, parm3 );
 }
@@ -931,6 +931,155 @@ const void *RB_StretchPic ( const void *data ) {
 }
 
 
+/*
+=============
+RB_AddQuad2D
+
+Adds a 2D quad to the current surface in the current 2D color,
+with the same vertices and indexes RB_StretchPic builds
+=============
+*/
+static void RB_AddQuad2D( float x, float y, float w, float h, float s1, float t1, float s2, float t2 ) {
+	int		numVerts, numIndexes;
+
+	RB_CHECKOVERFLOW( 4, 6 );
+	numVerts = tess.numVertexes;
+	numIndexes = tess.numIndexes;
+
+	tess.numVertexes += 4;
+	tess.numIndexes += 6;
+
+	tess.indexes[ numIndexes ] = numVerts + 3;
+	tess.indexes[ numIndexes + 1 ] = numVerts + 0;
+	tess.indexes[ numIndexes + 2 ] = numVerts + 2;
+	tess.indexes[ numIndexes + 3 ] = numVerts + 2;
+	tess.indexes[ numIndexes + 4 ] = numVerts + 0;
+	tess.indexes[ numIndexes + 5 ] = numVerts + 1;
+
+	*(int *)tess.vertexColors[ numVerts ] =
+		*(int *)tess.vertexColors[ numVerts + 1 ] =
+		*(int *)tess.vertexColors[ numVerts + 2 ] =
+		*(int *)tess.vertexColors[ numVerts + 3 ] = *(int *)backEnd.color2D;
+
+	tess.xyz[ numVerts ][0] = x;
+	tess.xyz[ numVerts ][1] = y;
+	tess.xyz[ numVerts ][2] = 0;
+
+	tess.texCoords[ numVerts ][0][0] = s1;
+	tess.texCoords[ numVerts ][0][1] = t1;
+
+	tess.xyz[ numVerts + 1 ][0] = x + w;
+	tess.xyz[ numVerts + 1 ][1] = y;
+	tess.xyz[ numVerts + 1 ][2] = 0;
+
+	tess.texCoords[ numVerts + 1 ][0][0] = s2;
+	tess.texCoords[ numVerts + 1 ][0][1] = t1;
+
+	tess.xyz[ numVerts + 2 ][0] = x + w;
+	tess.xyz[ numVerts + 2 ][1] = y + h;
+	tess.xyz[ numVerts + 2 ][2] = 0;
+
+	tess.texCoords[ numVerts + 2 ][0][0] = s2;
+	tess.texCoords[ numVerts + 2 ][0][1] = t2;
+
+	tess.xyz[ numVerts + 3 ][0] = x;
+	tess.xyz[ numVerts + 3 ][1] = y + h;
+	tess.xyz[ numVerts + 3 ][2] = 0;
+
+	tess.texCoords[ numVerts + 3 ][0][0] = s1;
+	tess.texCoords[ numVerts + 3 ][0][1] = t2;
+}
+
+
+/*
+=============
+RB_SetShader2D
+
+Starts a new surface when a 2D draw uses a different shader
+=============
+*/
+static void RB_SetShader2D( shader_t *shader ) {
+	if ( shader != tess.shader ) {
+		if ( tess.numIndexes ) {
+			RB_EndSurface();
+		}
+		backEnd.currentEntity = &backEnd.entity2D;
+		RB_BeginSurface( shader, 0 );
+	}
+}
+
+
+/*
+=============
+RB_DrawString
+
+Expands a character run into quads, producing the same vertices
+as one RB_StretchPic per visible character.
+=============
+*/
+const void *RB_DrawString( const void *data ) {
+	const drawStringCommand_t	*cmd;
+	const byte	*text;
+	int		i, ch;
+	float	s1, t1;
+	int		textBytes;
+
+	cmd = (const drawStringCommand_t *)data;
+	text = (const byte *)(cmd + 1);
+	textBytes = ( cmd->numChars + sizeof( void * ) - 1 ) & ~( sizeof( void * ) - 1 );
+
+	if ( !backEnd.projection2D ) {
+		RB_SetGL2D();
+	}
+
+	RB_SetShader2D( cmd->shader );
+
+	for ( i = 0 ; i < cmd->numChars ; i++ ) {
+		ch = text[i];
+		if ( ch == ' ' ) {
+			continue;
+		}
+
+		s1 = ( ch & 15 ) * 0.0625;
+		t1 = ( ch >> 4 ) * 0.0625;
+		RB_AddQuad2D( cmd->x + i * cmd->w, cmd->y, cmd->w, cmd->h,
+			s1, t1, s1 + 0.0625, t1 + 0.0625 );
+	}
+
+	return (const void *)( text + textBytes );
+}
+
+
+/*
+=============
+RB_DrawGlyphString
+
+Expands a glyph run into quads, producing the same vertices
+as one RB_StretchPic per glyph.
+=============
+*/
+const void *RB_DrawGlyphString( const void *data ) {
+	const drawGlyphStringCommand_t	*cmd;
+	const drawGlyph_t	*glyph;
+	int		i;
+
+	cmd = (const drawGlyphStringCommand_t *)data;
+	glyph = (const drawGlyph_t *)(cmd + 1);
+
+	if ( !backEnd.projection2D ) {
+		RB_SetGL2D();
+	}
+
+	for ( i = 0 ; i < cmd->numGlyphs ; i++, glyph++ ) {
+		RB_SetShader2D( glyph->shader );
+		RB_AddQuad2D( cmd->x + glyph->x, cmd->y + glyph->y, glyph->w, glyph->h,
+			glyph->s1, glyph->t1, glyph->s2, glyph->t2 );
+	}
+
+	return (const void *)glyph;
+}
+
+
 /*
 =============
 RB_DrawSurfs
@@ -1119,6 +1268,12 @@ void RB_ExecuteRenderCommands( const void *data ) {
 		case RC_STRETCH_PIC:
 			data = RB_StretchPic( data );
 			break;
+		case RC_DRAW_STRING:
+			data = RB_DrawString( data );
+			break;
+		case RC_DRAW_GLYPH_STRING:
+			data = RB_DrawGlyphString( data );
+			break;
 		case RC_DRAW_SURFS:
 			data = RB_DrawSurfs( data );
 			break;
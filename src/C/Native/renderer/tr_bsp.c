@@ -1708,6 +1708,7 @@ void R_LoadLightGrid( lump_t *l ) {
 	if (l->filelen != numGridPoints * 8) {
 		ri.Printf(PRINT_WARNING, "WARNING: light grid mismatch\n");
 		w->lightGridData = NULL;
+		w->lightGridNormals = NULL;
 		return;
 	}
 
@@ -1720,6 +1721,29 @@ void R_LoadLightGrid( lump_t *l ) {
 		R_ColorShiftLightingBytes(&w->lightGridData[i * 8 + 3], &w->lightGridData[i * 8 + 3]);
 	}
 
+	// decode the lat/long directions once, instead of going
+	// through the sin table for every entity sample
+	w->lightGridNormals = ri.Hunk_Alloc(numGridPoints * 3 * sizeof(float), h_low);
+	for (i = 0; i < numGridPoints; i++) {
+		int		lat, lng;
+		float	*normal;
+
+		lat = w->lightGridData[i * 8 + 7] * (FUNCTABLE_SIZE / 256);
+		lng = w->lightGridData[i * 8 + 6] * (FUNCTABLE_SIZE / 256);
+		normal = w->lightGridNormals + i * 3;
+
+		// decode X as cos( lat ) * sin( long )
+		// decode Y as sin( lat ) * sin( long )
+		// decode Z as cos( long )
+
+		normal[0] = tr.sinTable[(lat + (FUNCTABLE_SIZE / 4)) & FUNCTABLE_MASK] * tr.sinTable[lng];
+		normal[1] = tr.sinTable[lat] * tr.sinTable[lng];
+		normal[2] = tr.sinTable[(lng + (FUNCTABLE_SIZE / 4)) & FUNCTABLE_MASK];
+	}
+
+	// any cached samples belong to the previous map
+	R_ClearLightGridCache();
+
 	{
 		MObject *unit;
 
@@ -69,6 +69,11 @@ void R_PerformanceCounters( void ) {
 		ri.Printf( PRINT_ALL, "flare adds:%i tests:%i renders:%i\n", 
 			backEnd.pc.c_flareAdds, backEnd.pc.c_flareTests, backEnd.pc.c_flareRenders );
 	}
+	else if (r_speeds->integer == 7 )
+	{
+		ri.Printf( PRINT_ALL, "light grid cache hits:%i misses:%i\n",
+			tr.pc.c_lightCacheHits, tr.pc.c_lightCacheMisses );
+	}
 
 	Com_Memset( &tr.pc, 0, sizeof( tr.pc ) );
 	Com_Memset( &backEnd.pc, 0, sizeof( backEnd.pc ) );
@@ -293,6 +298,109 @@ void RE_StretchPic ( float x, float y, float w, float h,
 	cmd->t2 = t2;
 }
 
+/*
+=============
+RE_DrawString
+
+Queues a run of characters from a 16x16 character set image as a
+single command instead of one stretch pic per character.  Color
+escapes are not interpreted; callers split the run where the color
+changes.
+=============
+*/
+void RE_DrawString( float x, float y, float w, float h, const char *string, int numChars, qhandle_t hShader ) {
+	drawStringCommand_t	*cmd;
+	int		textBytes;
+
+	if ( !tr.registered ) {
+		return;
+	}
+	if ( numChars <= 0 ) {
+		return;
+	}
+
+	// keep the following command pointer aligned
+	textBytes = ( numChars + sizeof( void * ) - 1 ) & ~( sizeof( void * ) - 1 );
+
+	cmd = R_GetCommandBuffer( sizeof( *cmd ) + textBytes );
+	if ( !cmd ) {
+		return;
+	}
+	cmd->commandId = RC_DRAW_STRING;
+	cmd->shader = R_GetShaderByHandle( hShader );
+	cmd->x = x;
+	cmd->y = y;
+	cmd->w = w;
+	cmd->h = h;
+	cmd->numChars = numChars;
+	Com_Memcpy( cmd + 1, string, numChars );
+}
+
+/*
+=============
+RE_DrawGlyphString
+
+Queues a run of glyphs from a font loaded with RE_RegisterFont as a
+single command.  The glyph texture coordinates and sizes are copied
+into the command, so the font only has to be valid during the call.
+Glyphs without an image only advance the pen.
+=============
+*/
+void RE_DrawGlyphString( float x, float y, float xScale, float yScale, float adjust,
+						const fontInfo_t *font, const char *string, int numChars ) {
+	drawGlyphStringCommand_t	*cmd;
+	drawGlyph_t	*glyph;
+	const glyphInfo_t	*info;
+	int		i, numGlyphs;
+	float	pen;
+
+	if ( !tr.registered ) {
+		return;
+	}
+	if ( numChars <= 0 ) {
+		return;
+	}
+
+	numGlyphs = 0;
+	for ( i = 0 ; i < numChars ; i++ ) {
+		info = &font->glyphs[ (byte)string[i] ];
+		if ( info->imageWidth && info->imageHeight ) {
+			numGlyphs++;
+		}
+	}
+	if ( !numGlyphs ) {
+		return;
+	}
+
+	cmd = R_GetCommandBuffer( sizeof( *cmd ) + numGlyphs * sizeof( drawGlyph_t ) );
+	if ( !cmd ) {
+		return;
+	}
+	cmd->commandId = RC_DRAW_GLYPH_STRING;
+	cmd->x = x;
+	cmd->y = y;
+	cmd->numGlyphs = numGlyphs;
+
+	glyph = (drawGlyph_t *)( cmd + 1 );
+	pen = 0;
+	for ( i = 0 ; i < numChars ; i++ ) {
+		info = &font->glyphs[ (byte)string[i] ];
+		if ( info->imageWidth && info->imageHeight ) {
+			glyph->shader = R_GetShaderByHandle( info->glyph );
+			glyph->x = pen;
+			glyph->y = -info->top * yScale;
+			glyph->w = info->imageWidth * xScale;
+			glyph->h = info->imageHeight * yScale;
+			glyph->s1 = info->s;
+			glyph->t1 = info->t;
+			glyph->s2 = info->s2;
+			glyph->t2 = info->t2;
+			glyph++;
+		}
+		pen += info->xSkip * xScale + adjust;
+	}
+}
+
 
 /*
 ====================
@@ -139,6 +139,7 @@ cvar_t	*r_showImages;
 cvar_t	*r_ambientScale;
 cvar_t	*r_directedScale;
 cvar_t	*r_debugLight;
+cvar_t	*r_lightGridCache;
 cvar_t	*r_debugSort;
 cvar_t	*r_printShaders;
 cvar_t	*r_saveFontData;
@@ -944,6 +945,7 @@ void R_Register( void )
 
 	r_ambientScale = ri.Cvar_Get( "r_ambientScale", "0.6", CVAR_CHEAT );
 	r_directedScale = ri.Cvar_Get( "r_directedScale", "1", CVAR_CHEAT );
+	r_lightGridCache = ri.Cvar_Get( "r_lightGridCache", "1", CVAR_ARCHIVE );
 
 	//
 	// temporary variables that can change at any time
@@ -1205,6 +1207,8 @@ refexport_t *GetRefAPI ( int apiVersion, refimport_t *rimp ) {
 
 	re.SetColor = RE_SetColor;
 	re.DrawStretchPic = RE_StretchPic;
+	re.DrawString = RE_DrawString;
+	re.DrawGlyphString = RE_DrawGlyphString;
 	re.DrawStretchRaw = RE_StretchRaw;
 	re.UploadCinematic = RE_UploadCinematic;
 
@@ -116,33 +116,28 @@ LIGHT SAMPLING
 extern	cvar_t	*r_ambientScale;
 extern	cvar_t	*r_directedScale;
 extern	cvar_t	*r_debugLight;
+extern	cvar_t	*r_lightGridCache;
 
 /*
 =================
-R_SetupEntityLightingGrid
+R_SampleLightGrid
 
+Trilerps the raw light grid at the given point.  The results are
+not yet scaled by r_ambientScale / r_directedScale.
 =================
 */
-static void R_SetupEntityLightingGrid( trRefEntity_t *ent ) {
+static void R_SampleLightGrid( const vec3_t point, vec3_t ambientLight, vec3_t directedLight, vec3_t lightDir ) {
 	vec3_t	lightOrigin;
 	int		pos[3];
 	int		i, j;
 	byte	*gridData;
+	float	*gridNormals;
 	float	frac[3];
 	int		gridStep[3];
 	vec3_t	direction;
 	float	totalFactor;
 
-	if ( ent->e.renderfx & RF_LIGHTING_ORIGIN ) {
-		// seperate lightOrigins are needed so an object that is
-		// sinking into the ground can still be lit, and so
-		// multi-part models can be lit identically
-		VectorCopy( ent->e.lightingOrigin, lightOrigin );
-	} else {
-		VectorCopy( ent->e.origin, lightOrigin );
-	}
-
-	VectorSubtract( lightOrigin, tr.world->lightGridOrigin, lightOrigin );
+	VectorSubtract( point, tr.world->lightGridOrigin, lightOrigin );
 	for ( i = 0 ; i < 3 ; i++ ) {
 		float	v;
 
@@ -156,34 +151,36 @@ static void R_SetupEntityLightingGrid( trRefEntity_t *ent ) {
 		}
 	}
 
-	VectorClear( ent->ambientLight );
-	VectorClear( ent->directedLight );
+	VectorClear( ambientLight );
+	VectorClear( directedLight );
 	VectorClear( direction );
 
 	assert( tr.world->lightGridData ); // bk010103 - NULL with -nolight maps
 
 	// trilerp the light value
-	gridStep[0] = 8;
-	gridStep[1] = 8 * tr.world->lightGridBounds[0];
-	gridStep[2] = 8 * tr.world->lightGridBounds[0] * tr.world->lightGridBounds[1];
-	gridData = tr.world->lightGridData + pos[0] * gridStep[0]
-		+ pos[1] * gridStep[1] + pos[2] * gridStep[2];
+	gridStep[0] = 1;
+	gridStep[1] = tr.world->lightGridBounds[0];
+	gridStep[2] = tr.world->lightGridBounds[0] * tr.world->lightGridBounds[1];
+	i = pos[0] * gridStep[0] + pos[1] * gridStep[1] + pos[2] * gridStep[2];
+	gridData = tr.world->lightGridData + i * 8;
+	gridNormals = tr.world->lightGridNormals + i * 3;
 
 	totalFactor = 0;
 	for ( i = 0 ; i < 8 ; i++ ) {
 		float	factor;
 		byte	*data;
-		int		lat, lng;
-		vec3_t	normal;
+		float	*normal;
 		#if idppc
 		float d0, d1, d2, d3, d4, d5;
 		#endif
 		factor = 1.0;
 		data = gridData;
+		normal = gridNormals;
 		for ( j = 0 ; j < 3 ; j++ ) {
 			if ( i & (1<<j) ) {
 				factor *= frac[j];
-				data += gridStep[j];
+				data += gridStep[j] * 8;
+				normal += gridStep[j] * 3;
 			} else {
 				factor *= (1.0f - frac[j]);
 			}
@@ -197,48 +194,132 @@ static void R_SetupEntityLightingGrid( trRefEntity_t *ent ) {
 		d0 = data[0]; d1 = data[1]; d2 = data[2];
 		d3 = data[3]; d4 = data[4]; d5 = data[5];
 
-		ent->ambientLight[0] += factor * d0;
-		ent->ambientLight[1] += factor * d1;
-		ent->ambientLight[2] += factor * d2;
+		ambientLight[0] += factor * d0;
+		ambientLight[1] += factor * d1;
+		ambientLight[2] += factor * d2;
 
-		ent->directedLight[0] += factor * d3;
-		ent->directedLight[1] += factor * d4;
-		ent->directedLight[2] += factor * d5;
+		directedLight[0] += factor * d3;
+		directedLight[1] += factor * d4;
+		directedLight[2] += factor * d5;
 		#else
-		ent->ambientLight[0] += factor * data[0];
-		ent->ambientLight[1] += factor * data[1];
-		ent->ambientLight[2] += factor * data[2];
+		ambientLight[0] += factor * data[0];
+		ambientLight[1] += factor * data[1];
+		ambientLight[2] += factor * data[2];
 
-		ent->directedLight[0] += factor * data[3];
-		ent->directedLight[1] += factor * data[4];
-		ent->directedLight[2] += factor * data[5];
+		directedLight[0] += factor * data[3];
+		directedLight[1] += factor * data[4];
+		directedLight[2] += factor * data[5];
 		#endif
-		lat = data[7];
-		lng = data[6];
-		lat *= (FUNCTABLE_SIZE/256);
-		lng *= (FUNCTABLE_SIZE/256);
-
-		// decode X as cos( lat ) * sin( long )
-		// decode Y as sin( lat ) * sin( long )
-		// decode Z as cos( long )
-
-		normal[0] = tr.sinTable[(lat+(FUNCTABLE_SIZE/4))&FUNCTABLE_MASK] * tr.sinTable[lng];
-		normal[1] = tr.sinTable[lat] * tr.sinTable[lng];
-		normal[2] = tr.sinTable[(lng+(FUNCTABLE_SIZE/4))&FUNCTABLE_MASK];
 
+		// the lat/long direction was decoded at load time
 		VectorMA( direction, factor, normal, direction );
 	}
 
 	if ( totalFactor > 0 && totalFactor < 0.99 ) {
 		totalFactor = 1.0f / totalFactor;
-		VectorScale( ent->ambientLight, totalFactor, ent->ambientLight );
-		VectorScale( ent->directedLight, totalFactor, ent->directedLight );
+		VectorScale( ambientLight, totalFactor, ambientLight );
+		VectorScale( directedLight, totalFactor, directedLight );
+	}
+
+	VectorNormalize2( direction, lightDir );
+}
+
+
+/*
+=============================================================================
+
+LIGHT GRID CACHE
+
+Most lit entities (items, static models, idle players) sample the
+grid at exactly the same point frame after frame, and every mirror or
+portal view samples them again.  The raw trilerp result is kept in a
+small direct mapped table keyed by the light origin, so a hit costs a
+hash and a compare.  Dynamic lights are applied afterwards by
+R_SetupEntityLighting, so they never need to invalidate an entry.
+
+=============================================================================
+*/
+
+#define	LIGHTCACHE_SIZE		1024		// must be a power of two
+#define	LIGHTCACHE_MASK		( LIGHTCACHE_SIZE - 1 )
+
+typedef struct {
+	qboolean	valid;
+	vec3_t		origin;
+	vec3_t		ambientLight;
+	vec3_t		directedLight;
+	vec3_t		lightDir;
+} lightCacheEntry_t;
+
+static lightCacheEntry_t	lightCache[LIGHTCACHE_SIZE];
+
+/*
+=================
+R_ClearLightGridCache
+
+Must be called whenever the light grid changes
+=================
+*/
+void R_ClearLightGridCache( void ) {
+	Com_Memset( lightCache, 0, sizeof( lightCache ) );
+}
+
+/*
+=================
+R_LightCacheHash
+
+Quantizes the origin to whole units so that nearby points land in
+the same bucket, the exact origin is still compared on lookup.
+=================
+*/
+static int R_LightCacheHash( const vec3_t point ) {
+	int		hash;
+
+	hash = myftol( point[0] ) * 73856093;
+	hash ^= myftol( point[1] ) * 19349663;
+	hash ^= myftol( point[2] ) * 83492791;
+
+	return hash & LIGHTCACHE_MASK;
+}
+
+/*
+=================
+R_SetupEntityLightingGrid
+
+=================
+*/
+static void R_SetupEntityLightingGrid( trRefEntity_t *ent ) {
+	vec3_t				lightOrigin;
+	lightCacheEntry_t	*entry;
+
+	if ( ent->e.renderfx & RF_LIGHTING_ORIGIN ) {
+		// seperate lightOrigins are needed so an object that is
+		// sinking into the ground can still be lit, and so
+		// multi-part models can be lit identically
+		VectorCopy( ent->e.lightingOrigin, lightOrigin );
+	} else {
+		VectorCopy( ent->e.origin, lightOrigin );
+	}
+
+	if ( r_lightGridCache->integer ) {
+		entry = &lightCache[ R_LightCacheHash( lightOrigin ) ];
+		if ( !entry->valid || !VectorCompare( entry->origin, lightOrigin ) ) {
+			R_SampleLightGrid( lightOrigin, entry->ambientLight, entry->directedLight, entry->lightDir );
+			VectorCopy( lightOrigin, entry->origin );
+			entry->valid = qtrue;
+			tr.pc.c_lightCacheMisses++;
+		} else {
+			tr.pc.c_lightCacheHits++;
+		}
+		VectorCopy( entry->ambientLight, ent->ambientLight );
+		VectorCopy( entry->directedLight, ent->directedLight );
+		VectorCopy( entry->lightDir, ent->lightDir );
+	} else {
+		R_SampleLightGrid( lightOrigin, ent->ambientLight, ent->directedLight, ent->lightDir );
 	}
 
 	VectorScale( ent->ambientLight, r_ambientScale->value, ent->ambientLight );
 	VectorScale( ent->directedLight, r_directedScale->value, ent->directedLight );
-
-	VectorNormalize2( direction, ent->lightDir );
 }
 
 
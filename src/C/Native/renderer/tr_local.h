@@ -589,6 +589,14 @@ typedef struct srfGridMesh_s {
 	int				width, height;
 	float			*widthLodError;
 	float			*heightLodError;
+
+	// rows and columns picked by the last RB_SurfaceGrid, these
+	// stay valid while the lod error is in [lodCacheMin, lodCacheMax)
+	float			lodCacheMin, lodCacheMax;
+	int				lodWidth, lodHeight;
+	byte			lodWidthTable[MAX_GRID_SIZE];
+	byte			lodHeightTable[MAX_GRID_SIZE];
+
 	drawVert_t		verts[1];		// variable sized
 } srfGridMesh_t;
 
@@ -719,6 +727,7 @@ typedef struct {
 	vec3_t		lightGridInverseSize;
 	int			lightGridBounds[3];
 	byte		*lightGridData;
+	float		*lightGridNormals;		// decoded lat/long directions, 3 floats per point
 
 
 	int			numClusters;
@@ -812,6 +821,8 @@ typedef struct {
 	int		c_leafs;
 	int		c_dlightSurfaces;
 	int		c_dlightSurfacesCulled;
+
+	int		c_lightCacheHits, c_lightCacheMisses;
 } frontEndCounters_t;
 
 #define	FOG_TABLE_SIZE		256
@@ -1059,6 +1070,8 @@ extern	cvar_t	*r_clear;						// force screen clear every frame
 extern	cvar_t	*r_shadows;						// controls shadows: 0 = none, 1 = blur, 2 = stencil, 3 = black planar projection
 extern	cvar_t	*r_flares;						// light flares
 
+extern	cvar_t	*r_lightGridCache;				// reuse light grid samples for entities that haven't moved
+
 extern	cvar_t	*r_intensity;
 
 extern	cvar_t	*r_lockpvs;
@@ -1095,6 +1108,7 @@ void R_SwapBuffers( int );
 void R_RenderView( viewParms_t *parms );
 
 void R_AddMD3Surfaces( trRefEntity_t *e );
+qboolean R_CullMD3Entity( trRefEntity_t *ent, model_t *model );
 void R_AddNullModelSurfaces( trRefEntity_t *e );
 void R_AddBeamSurfaces( trRefEntity_t *e );
 void R_AddRailSurfaces( trRefEntity_t *e, qboolean isUnderwater );
@@ -1352,6 +1366,7 @@ void R_DlightBmodel( bmodel_t *bmodel );
 void R_SetupEntityLighting( const trRefdef_t *refdef, trRefEntity_t *ent );
 void R_TransformDlights( int count, dlight_t *dl, orientationr_t *or );
 int R_LightForPoint( vec3_t point, vec3_t ambientLight, vec3_t directedLight, vec3_t lightDir );
+void R_ClearLightGridCache( void );
 
 
 /*
@@ -1529,6 +1544,33 @@ typedef struct {
 	float	s2, t2;
 } stretchPicCommand_t;
 
+// a run of characters from a 16x16 character set image, drawn as
+// one quad per character; numChars bytes of text follow the header
+typedef struct {
+	int		commandId;
+	shader_t	*shader;
+	float	x, y;
+	float	w, h;		// size of a single character
+	int		numChars;
+} drawStringCommand_t;
+
+// a glyph of a registered font, positioned relative to the start of the run
+typedef struct {
+	shader_t	*shader;
+	float	x, y;
+	float	w, h;
+	float	s1, t1;
+	float	s2, t2;
+} drawGlyph_t;
+
+// a run of glyphs from a registered font; the glyph metrics are copied
+// from the font, numGlyphs drawGlyph_t follow the header
+typedef struct {
+	int		commandId;
+	float	x, y;
+	int		numGlyphs;
+} drawGlyphStringCommand_t;
+
 typedef struct {
 	int		commandId;
 	trRefdef_t	refdef;
@@ -1551,6 +1593,8 @@ typedef enum {
 	RC_END_OF_LIST,
 	RC_SET_COLOR,
 	RC_STRETCH_PIC,
+	RC_DRAW_STRING,
+	RC_DRAW_GLYPH_STRING,
 	RC_DRAW_SURFS,
 	RC_DRAW_BUFFER,
 	RC_SWAP_BUFFERS,
@@ -1600,6 +1644,9 @@ void R_AddDrawSurfCmd( drawSurf_t *drawSurfs, int numDrawSurfs );
 void RE_SetColor( const float *rgba );
 void RE_StretchPic ( float x, float y, float w, float h, 
 					  float s1, float t1, float s2, float t2, qhandle_t hShader );
+void RE_DrawString( float x, float y, float w, float h, const char *string, int numChars, qhandle_t hShader );
+void RE_DrawGlyphString( float x, float y, float xScale, float yScale, float adjust,
+						const fontInfo_t *font, const char *string, int numChars );
 void RE_BeginFrame( stereoFrame_t stereoFrame );
 void RE_EndFrame( int *frontEndMsec, int *backEndMsec );
 void SaveJPG(char * filename, int quality, int image_width, int image_height, unsigned char *image_buffer);
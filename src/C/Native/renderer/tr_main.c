@@ -1585,10 +1585,18 @@ void R_AddEntitySurfaces (void) {
 			break;
 
 		case RT_MODEL:
+			tr.currentModel = R_GetModelByHandle( ent->e.hModel );
+
+			// reject meshes that are completely out of view before
+			// paying for the orientation and LOD setup
+			if ( tr.currentModel && tr.currentModel->type == MOD_MESH
+				&& R_CullMD3Entity( ent, tr.currentModel ) ) {
+				break;
+			}
+
 			// we must set up parts of tr.or for model culling
 			R_RotateForEntity( ent, &tr.viewParms, &tr.or );
 
-			tr.currentModel = R_GetModelByHandle( ent->e.hModel );
 			if (!tr.currentModel) {
 				R_AddDrawSurf( &entitySurface, tr.defaultShader, 0, 0 );
 			} else {
@@ -304,6 +304,105 @@ int R_ComputeFogNum( md3Header_t *header, trRefEntity_t *ent ) {
 	return 0;
 }
 
+/*
+=================
+R_ValidateMD3Frames
+
+Validate the frames so there is no chance of a crash.
+This will write directly into the entity structure, so
+when the surfaces are rendered, they don't need to be
+range checked again.
+=================
+*/
+static void R_ValidateMD3Frames( trRefEntity_t *ent, model_t *model ) {
+	if ( ent->e.renderfx & RF_WRAP_FRAMES ) {
+		ent->e.frame %= model->md3[0]->numFrames;
+		ent->e.oldframe %= model->md3[0]->numFrames;
+	}
+
+	if ( (ent->e.frame >= model->md3[0]->numFrames) 
+		|| (ent->e.frame < 0)
+		|| (ent->e.oldframe >= model->md3[0]->numFrames)
+		|| (ent->e.oldframe < 0) ) {
+			ri.Printf( PRINT_DEVELOPER, "R_AddMD3Surfaces: no such frame %d to %d for '%s'\n",
+				ent->e.oldframe, ent->e.frame,
+				model->name );
+			ent->e.frame = 0;
+			ent->e.oldframe = 0;
+	}
+}
+
+/*
+=================
+R_FrameSphereOutside
+
+Tests a frame's bounding sphere against the view frustum
+directly in world space, without needing tr.or.
+=================
+*/
+static qboolean R_FrameSphereOutside( trRefEntity_t *ent, md3Frame_t *frame ) {
+	int			i;
+	vec3_t		center;
+	cplane_t	*frust;
+
+	// same transform R_RotateForEntity would set up for an RT_MODEL
+	VectorCopy( ent->e.origin, center );
+	VectorMA( center, frame->localOrigin[0], ent->e.axis[0], center );
+	VectorMA( center, frame->localOrigin[1], ent->e.axis[1], center );
+	VectorMA( center, frame->localOrigin[2], ent->e.axis[2], center );
+
+	for ( i = 0 ; i < 4 ; i++ ) {
+		frust = &tr.viewParms.frustum[i];
+
+		if ( DotProduct( center, frust->normal ) - frust->dist < -frame->radius ) {
+			return qtrue;
+		}
+	}
+
+	return qfalse;
+}
+
+/*
+=================
+R_CullMD3Entity
+
+Called by R_AddEntitySurfaces before the entity orientation is
+set up.  Returns qtrue only when the bounding spheres of both
+frames are outside the frustum for every LOD, which is exactly
+the case where R_CullModel would reject the entity whatever LOD
+gets selected.  Crowded scenes have many models behind the view,
+and those no longer pay for R_RotateForEntity and R_ComputeLOD.
+=================
+*/
+qboolean R_CullMD3Entity( trRefEntity_t *ent, model_t *model ) {
+	int				lod;
+	md3Header_t		*header;
+	md3Frame_t		*oldFrame, *newFrame;
+
+	// the sphere test is only valid for normalized axes
+	if ( r_nocull->integer || ent->e.nonNormalizedAxes ) {
+		return qfalse;
+	}
+
+	R_ValidateMD3Frames( ent, model );
+
+	for ( lod = 0 ; lod < model->numLods ; lod++ ) {
+		header = model->md3[lod];
+		newFrame = ( md3Frame_t * ) ( ( byte * ) header + header->ofsFrames ) + ent->e.frame;
+		oldFrame = ( md3Frame_t * ) ( ( byte * ) header + header->ofsFrames ) + ent->e.oldframe;
+
+		if ( !R_FrameSphereOutside( ent, newFrame ) ) {
+			return qfalse;
+		}
+		if ( oldFrame != newFrame && !R_FrameSphereOutside( ent, oldFrame ) ) {
+			return qfalse;
+		}
+	}
+
+	tr.pc.c_sphere_cull_md3_out++;
+	return qtrue;
+}
+
 /*
 =================
 R_AddMD3Surfaces
@@ -324,27 +423,7 @@ void R_AddMD3Surfaces( trRefEntity_t *ent ) {
 	// don't add third_person objects if not in a portal
 	personalModel = (ent->e.renderfx & RF_THIRD_PERSON) && !tr.viewParms.isPortal;
 
-	if ( ent->e.renderfx & RF_WRAP_FRAMES ) {
-		ent->e.frame %= tr.currentModel->md3[0]->numFrames;
-		ent->e.oldframe %= tr.currentModel->md3[0]->numFrames;
-	}
-
-	//
-	// Validate the frames so there is no chance of a crash.
-	// This will write directly into the entity structure, so
-	// when the surfaces are rendered, they don't need to be
-	// range checked again.
-	//
-	if ( (ent->e.frame >= tr.currentModel->md3[0]->numFrames) 
-		|| (ent->e.frame < 0)
-		|| (ent->e.oldframe >= tr.currentModel->md3[0]->numFrames)
-		|| (ent->e.oldframe < 0) ) {
-			ri.Printf( PRINT_DEVELOPER, "R_AddMD3Surfaces: no such frame %d to %d for '%s'\n",
-				ent->e.oldframe, ent->e.frame,
-				tr.currentModel->name );
-			ent->e.frame = 0;
-			ent->e.oldframe = 0;
-	}
+	R_ValidateMD3Frames( ent, tr.currentModel );
 
 	//
 	// compute LOD
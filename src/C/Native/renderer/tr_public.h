@@ -72,6 +72,13 @@ typedef struct {
 	void	(*SetColor)( const float *rgba );	// NULL = 1,1,1,1
 	void	(*DrawStretchPic) ( float x, float y, float w, float h, 
 		float s1, float t1, float s2, float t2, qhandle_t hShader );	// 0 = white
+	// a run of characters from a 16x16 character set, no color escapes
+	void	(*DrawString) ( float x, float y, float w, float h, 
+		const char *string, int numChars, qhandle_t hShader );
+	// a run of glyphs from a registered font, no color escapes, the scales
+	// are the screen size of a font pixel and adjust is added after each glyph
+	void	(*DrawGlyphString) ( float x, float y, float xScale, float yScale, float adjust,
+		const fontInfo_t *font, const char *string, int numChars );
 
 	// Draw images for cinematic rendering, pass as 32 bit rgba
 	void	(*DrawStretchRaw) (int x, int y, int w, int h, int cols, int rows, const byte *data, int client, qboolean dirty);
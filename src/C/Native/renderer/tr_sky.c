@@ -28,6 +28,12 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 static float s_cloudTexCoords[6][SKY_SUBDIVISIONS+1][SKY_SUBDIVISIONS+1][2];
 static float s_cloudTexP[6][SKY_SUBDIVISIONS+1][SKY_SUBDIVISIONS+1];
 
+// sky box directions for a box size of 1, and the matching outer box
+// texture coordinates, which are the same for every side
+static vec3_t	s_skyUnitVecs[6][SKY_SUBDIVISIONS+1][SKY_SUBDIVISIONS+1];
+static float	s_skyBoxTexCoords[SKY_SUBDIVISIONS+1][SKY_SUBDIVISIONS+1][2];
+static qboolean	s_skyGeometryInitialized;
+
 /*
 ===================================================================================
 
@@ -47,7 +53,6 @@ static vec3_t sky_clip[6] =
 };
 
 static float	sky_mins[2][6], sky_maxs[2][6];
-static float	sky_min, sky_max;
 
 /*
 ================
@@ -252,6 +257,40 @@ static void ClearSkyBox (void) {
 	}
 }
 
+/*
+================
+SkyTriangleCrossesClip
+
+Returns qfalse if the triangle is entirely on one side (or on) each
+of the six clip planes.  ClipSkyPolygon would pass such a triangle
+through all of its stages unchanged, so it can go straight to
+AddSkyPolygon.  Most sky triangles are small enough to take this path.
+================
+*/
+static qboolean SkyTriangleCrossesClip( vec3_t p[3] )
+{
+	int		i, j;
+	int		sides;
+	float	d;
+
+	for ( i = 0 ; i < 6 ; i++ )
+	{
+		sides = 0;
+		for ( j = 0 ; j < 3 ; j++ )
+		{
+			d = DotProduct( p[j], sky_clip[i] );
+			if ( d > ON_EPSILON )
+				sides |= 1;
+			else if ( d < -ON_EPSILON )
+				sides |= 2;
+		}
+		if ( sides == 3 )
+			return qtrue;
+	}
+
+	return qfalse;
+}
+
 /*
 ================
 RB_ClipSkyPolygons
@@ -272,6 +311,13 @@ void RB_ClipSkyPolygons( shaderCommands_t *input )
 							backEnd.viewParms.or.origin, 
 							p[j] );
 		}
+
+		if ( !SkyTriangleCrossesClip( p ) )
+		{
+			AddSkyPolygon( 3, p[0] );
+			continue;
+		}
+
 		ClipSkyPolygon( 3, p[0], 0 );
 	}
 }
@@ -284,12 +330,17 @@ CLOUD VERTEX GENERATION
 ===================================================================================
 */
 
+static int	sky_texorder[6] = {0,2,1,3,4,5};
+static vec3_t	s_skyPoints[SKY_SUBDIVISIONS+1][SKY_SUBDIVISIONS+1];
+
 /*
-** MakeSkyVec
+** R_InitSkyGeometry
 **
-** Parms: s, t range from -1 to 1
+** The box vertexes only change from frame to frame by the box size,
+** so the direction of every subdivision point is computed once and
+** scaled when drawing.  s and t range from -1 to 1.
 */
-static void MakeSkyVec( float s, float t, int axis, float outSt[2], vec3_t outXYZ )
+static void R_InitSkyGeometry( void )
 {
 	// 1 = s, 2 = t, 3 = 2048
 	static int	st_to_vec[6][3] =
@@ -305,62 +356,76 @@ static void MakeSkyVec( float s, float t, int axis, float outSt[2], vec3_t outXY
 	};
 
 	vec3_t		b;
-	int			j, k;
-	float	boxSize;
-
-	boxSize = backEnd.viewParms.zFar / 1.75;		// div sqrt(3)
-	b[0] = s*boxSize;
-	b[1] = t*boxSize;
-	b[2] = boxSize;
+	int			i, j, k;
+	int			s, t;
+	float		fs, ft;
 
-	for (j=0 ; j<3 ; j++)
+	if ( s_skyGeometryInitialized )
 	{
-		k = st_to_vec[axis][j];
-		if (k < 0)
-		{
-			outXYZ[j] = -b[-k - 1];
-		}
-		else
-		{
-			outXYZ[j] = b[k - 1];
-		}
+		return;
 	}
 
-	// avoid bilerp seam
-	s = (s+1)*0.5;
-	t = (t+1)*0.5;
-	if (s < sky_min)
+	for ( t = 0; t <= SKY_SUBDIVISIONS; t++ )
 	{
-		s = sky_min;
-	}
-	else if (s > sky_max)
-	{
-		s = sky_max;
-	}
+		for ( s = 0; s <= SKY_SUBDIVISIONS; s++ )
+		{
+			fs = ( s - HALF_SKY_SUBDIVISIONS ) / ( float ) HALF_SKY_SUBDIVISIONS;
+			ft = ( t - HALF_SKY_SUBDIVISIONS ) / ( float ) HALF_SKY_SUBDIVISIONS;
 
-	if (t < sky_min)
-	{
-		t = sky_min;
-	}
-	else if (t > sky_max)
-	{
-		t = sky_max;
+			b[0] = fs;
+			b[1] = ft;
+			b[2] = 1;
+
+			for ( i = 0; i < 6; i++ )
+			{
+				for ( j = 0 ; j < 3 ; j++ )
+				{
+					k = st_to_vec[i][j];
+					if ( k < 0 )
+					{
+						s_skyUnitVecs[i][t][s][j] = -b[-k - 1];
+					}
+					else
+					{
+						s_skyUnitVecs[i][t][s][j] = b[k - 1];
+					}
+				}
+			}
+
+			// avoid bilerp seam
+			fs = ( fs + 1 ) * 0.5;
+			ft = ( ft + 1 ) * 0.5;
+			ft = 1.0 - ft;
+
+			s_skyBoxTexCoords[t][s][0] = fs;
+			s_skyBoxTexCoords[t][s][1] = ft;
+		}
 	}
 
-	t = 1.0 - t;
+	s_skyGeometryInitialized = qtrue;
+}
 
+/*
+** MakeSkyPoints
+**
+** Scales the directions of one side out to the current box size
+*/
+static void MakeSkyPoints( int axis, const int mins[2], const int maxs[2] )
+{
+	int		s, t;
+	float	boxSize;
+
+	boxSize = backEnd.viewParms.zFar / 1.75;		// div sqrt(3)
 
-	if ( outSt )
+	for ( t = mins[1]+HALF_SKY_SUBDIVISIONS; t <= maxs[1]+HALF_SKY_SUBDIVISIONS; t++ )
 	{
-		outSt[0] = s;
-		outSt[1] = t;
+		for ( s = mins[0]+HALF_SKY_SUBDIVISIONS; s <= maxs[0]+HALF_SKY_SUBDIVISIONS; s++ )
+		{
+			VectorScale( s_skyUnitVecs[axis][t][s], boxSize, s_skyPoints[t][s] );
+		}
 	}
 }
 
-static int	sky_texorder[6] = {0,2,1,3,4,5};
-static vec3_t	s_skyPoints[SKY_SUBDIVISIONS+1][SKY_SUBDIVISIONS+1];
-static float	s_skyTexCoords[SKY_SUBDIVISIONS+1][SKY_SUBDIVISIONS+1][2];
-
 static void DrawSkySide( struct image_s *image, const int mins[2], const int maxs[2] )
 {
 	int s, t;
@@ -373,10 +438,10 @@ static void DrawSkySide( struct image_s *image, const int mins[2], const int max
 
 		for ( s = mins[0]+HALF_SKY_SUBDIVISIONS; s <= maxs[0]+HALF_SKY_SUBDIVISIONS; s++ )
 		{
-			qglTexCoord2fv( s_skyTexCoords[t][s] );
+			qglTexCoord2fv( s_skyBoxTexCoords[t][s] );
 			qglVertex3fv( s_skyPoints[t][s] );
 
-			qglTexCoord2fv( s_skyTexCoords[t+1][s] );
+			qglTexCoord2fv( s_skyBoxTexCoords[t+1][s] );
 			qglVertex3fv( s_skyPoints[t+1][s] );
 		}
 
@@ -388,15 +453,9 @@ static void DrawSkyBox( shader_t *shader )
 {
 	int		i;
 
-	sky_min = 0;
-	sky_max = 1;
-
-	Com_Memset( s_skyTexCoords, 0, sizeof( s_skyTexCoords ) );
-
 	for (i=0 ; i<6 ; i++)
 	{
 		int sky_mins_subd[2], sky_maxs_subd[2];
-		int s, t;
 
 		sky_mins[0][i] = floor( sky_mins[0][i] * HALF_SKY_SUBDIVISIONS ) / HALF_SKY_SUBDIVISIONS;
 		sky_mins[1][i] = floor( sky_mins[1][i] * HALF_SKY_SUBDIVISIONS ) / HALF_SKY_SUBDIVISIONS;
@@ -432,20 +491,7 @@ static void DrawSkyBox( shader_t *shader )
 		else if ( sky_maxs_subd[1] > HALF_SKY_SUBDIVISIONS ) 
 			sky_maxs_subd[1] = HALF_SKY_SUBDIVISIONS;
 
-		//
-		// iterate through the subdivisions
-		//
-		for ( t = sky_mins_subd[1]+HALF_SKY_SUBDIVISIONS; t <= sky_maxs_subd[1]+HALF_SKY_SUBDIVISIONS; t++ )
-		{
-			for ( s = sky_mins_subd[0]+HALF_SKY_SUBDIVISIONS; s <= sky_maxs_subd[0]+HALF_SKY_SUBDIVISIONS; s++ )
-			{
-				MakeSkyVec( ( s - HALF_SKY_SUBDIVISIONS ) / ( float ) HALF_SKY_SUBDIVISIONS, 
-							( t - HALF_SKY_SUBDIVISIONS ) / ( float ) HALF_SKY_SUBDIVISIONS, 
-							i, 
-							s_skyTexCoords[t][s], 
-							s_skyPoints[t][s] );
-			}
-		}
+		MakeSkyPoints( i, sky_mins_subd, sky_maxs_subd );
 
 		DrawSkySide( shader->sky.outerbox[sky_texorder[i]],
 			         sky_mins_subd,
@@ -454,7 +500,7 @@ static void DrawSkyBox( shader_t *shader )
 
 }
 
-static void FillCloudySkySide( const int mins[2], const int maxs[2], qboolean addIndexes )
+static void FillCloudySkySide( int axis, const int mins[2], const int maxs[2], qboolean addIndexes )
 {
 	int s, t;
 	int vertexStart = tess.numVertexes;
@@ -468,8 +514,8 @@ static void FillCloudySkySide( const int mins[2], const int maxs[2], qboolean ad
 		for ( s = mins[0]+HALF_SKY_SUBDIVISIONS; s <= maxs[0]+HALF_SKY_SUBDIVISIONS; s++ )
 		{
 			VectorAdd( s_skyPoints[t][s], backEnd.viewParms.or.origin, tess.xyz[tess.numVertexes] );
-			tess.texCoords[tess.numVertexes][0][0] = s_skyTexCoords[t][s][0];
-			tess.texCoords[tess.numVertexes][0][1] = s_skyTexCoords[t][s][1];
+			tess.texCoords[tess.numVertexes][0][0] = s_cloudTexCoords[axis][t][s][0];
+			tess.texCoords[tess.numVertexes][0][1] = s_cloudTexCoords[axis][t][s][1];
 
 			tess.numVertexes++;
 
@@ -511,7 +557,6 @@ static void FillCloudBox( const shader_t *shader, int stage )
 	for ( i =0; i < 6; i++ )
 	{
 		int sky_mins_subd[2], sky_maxs_subd[2];
-		int s, t;
 		float MIN_T;
 
 		if ( 1 ) // FIXME? shader->sky.fullClouds )
@@ -576,26 +621,10 @@ static void FillCloudBox( const shader_t *shader, int stage )
 		else if ( sky_maxs_subd[1] > HALF_SKY_SUBDIVISIONS ) 
 			sky_maxs_subd[1] = HALF_SKY_SUBDIVISIONS;
 
-		//
-		// iterate through the subdivisions
-		//
-		for ( t = sky_mins_subd[1]+HALF_SKY_SUBDIVISIONS; t <= sky_maxs_subd[1]+HALF_SKY_SUBDIVISIONS; t++ )
-		{
-			for ( s = sky_mins_subd[0]+HALF_SKY_SUBDIVISIONS; s <= sky_maxs_subd[0]+HALF_SKY_SUBDIVISIONS; s++ )
-			{
-				MakeSkyVec( ( s - HALF_SKY_SUBDIVISIONS ) / ( float ) HALF_SKY_SUBDIVISIONS, 
-							( t - HALF_SKY_SUBDIVISIONS ) / ( float ) HALF_SKY_SUBDIVISIONS, 
-							i, 
-							NULL,
-							s_skyPoints[t][s] );
-
-				s_skyTexCoords[t][s][0] = s_cloudTexCoords[i][t][s][0];
-				s_skyTexCoords[t][s][1] = s_cloudTexCoords[i][t][s][1];
-			}
-		}
+		MakeSkyPoints( i, sky_mins_subd, sky_maxs_subd );
 
 		// only add indexes for first stage
-		FillCloudySkySide( sky_mins_subd, sky_maxs_subd, ( stage == 0 ) );
+		FillCloudySkySide( i, sky_mins_subd, sky_maxs_subd, ( stage == 0 ) );
 	}
 }
 
@@ -611,9 +640,6 @@ void R_BuildCloudData( shaderCommands_t *input )
 
 	assert( shader->isSky );
 
-	sky_min = 1.0 / 256.0f;		// FIXME: not correct?
-	sky_max = 255.0 / 256.0f;
-
 	// set up for drawing
 	tess.numIndexes = 0;
 	tess.numVertexes = 0;
@@ -643,10 +669,13 @@ void R_InitSkyTexCoords( float heightCloud )
 	float sRad, tRad;
 	vec3_t skyVec;
 	vec3_t v;
+	float boxSize;
+
+	R_InitSkyGeometry();
 
-	// init zfar so MakeSkyVec works even though
-	// a world hasn't been bounded
-	backEnd.viewParms.zFar = 1024;
+	// the box size for a zfar of 1024, since
+	// a world hasn't been bounded yet
+	boxSize = 1024 / 1.75;
 
 	for ( i = 0; i < 6; i++ )
 	{
@@ -655,11 +684,7 @@ void R_InitSkyTexCoords( float heightCloud )
 			for ( s = 0; s <= SKY_SUBDIVISIONS; s++ )
 			{
 				// compute vector from view origin to sky side integral point
-				MakeSkyVec( ( s - HALF_SKY_SUBDIVISIONS ) / ( float ) HALF_SKY_SUBDIVISIONS, 
-							( t - HALF_SKY_SUBDIVISIONS ) / ( float ) HALF_SKY_SUBDIVISIONS, 
-							i, 
-							NULL,
-							skyVec );
+				VectorScale( s_skyUnitVecs[i][t][s], boxSize, skyVec );
 
 				// compute parametric value 'p' that intersects with cloud layer
 				p = ( 1.0f / ( 2 * DotProduct( skyVec, skyVec ) ) ) *
@@ -913,8 +913,8 @@ void RB_SurfaceGrid( srfGridMesh_t *cv ) {
 	drawVert_t	*dv;
 	int		rows, irows, vrows;
 	int		used;
-	int		widthTable[MAX_GRID_SIZE];
-	int		heightTable[MAX_GRID_SIZE];
+	byte	*widthTable;
+	byte	*heightTable;
 	float	lodError;
 	int		lodWidth, lodHeight;
 	int		numVertexes;
@@ -929,28 +929,59 @@ void RB_SurfaceGrid( srfGridMesh_t *cv ) {
 	lodError = LodErrorForVolume( cv->lodOrigin, cv->lodRadius );
 
 	// determine which rows and columns of the subdivision
-	// we are actually going to use
-	widthTable[0] = 0;
-	lodWidth = 1;
-	for ( i = 1 ; i < cv->width-1 ; i++ ) {
-		if ( cv->widthLodError[i] <= lodError ) {
-			widthTable[lodWidth] = i;
-			lodWidth++;
+	// we are actually going to use, unless the error still
+	// selects the same ones as last time
+	widthTable = cv->lodWidthTable;
+	heightTable = cv->lodHeightTable;
+
+	if ( lodError < cv->lodCacheMin || lodError >= cv->lodCacheMax ) {
+		float	lodMin, lodMax;
+
+		// the selection holds from the largest error taken
+		// up to (not including) the smallest error skipped
+		lodMin = 0;
+		lodMax = 1e30f;
+
+		widthTable[0] = 0;
+		lodWidth = 1;
+		for ( i = 1 ; i < cv->width-1 ; i++ ) {
+			if ( cv->widthLodError[i] <= lodError ) {
+				widthTable[lodWidth] = i;
+				lodWidth++;
+				if ( cv->widthLodError[i] > lodMin ) {
+					lodMin = cv->widthLodError[i];
+				}
+			} else if ( cv->widthLodError[i] < lodMax ) {
+				lodMax = cv->widthLodError[i];
+			}
 		}
-	}
-	widthTable[lodWidth] = cv->width-1;
-	lodWidth++;
-
-	heightTable[0] = 0;
-	lodHeight = 1;
-	for ( i = 1 ; i < cv->height-1 ; i++ ) {
-		if ( cv->heightLodError[i] <= lodError ) {
-			heightTable[lodHeight] = i;
-			lodHeight++;
+		widthTable[lodWidth] = cv->width-1;
+		lodWidth++;
+
+		heightTable[0] = 0;
+		lodHeight = 1;
+		for ( i = 1 ; i < cv->height-1 ; i++ ) {
+			if ( cv->heightLodError[i] <= lodError ) {
+				heightTable[lodHeight] = i;
+				lodHeight++;
+				if ( cv->heightLodError[i] > lodMin ) {
+					lodMin = cv->heightLodError[i];
+				}
+			} else if ( cv->heightLodError[i] < lodMax ) {
+				lodMax = cv->heightLodError[i];
+			}
 		}
+		heightTable[lodHeight] = cv->height-1;
+		lodHeight++;
+
+		cv->lodCacheMin = lodMin;
+		cv->lodCacheMax = lodMax;
+		cv->lodWidth = lodWidth;
+		cv->lodHeight = lodHeight;
+	} else {
+		lodWidth = cv->lodWidth;
+		lodHeight = cv->lodHeight;
 	}
-	heightTable[lodHeight] = cv->height-1;
-	lodHeight++;
 
 
 	// very large grids may have more points or indexes than can be fit
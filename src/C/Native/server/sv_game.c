@@ -489,6 +489,8 @@ int SV_GameSystemCalls( int *args ) {
 	case BOTLIB_USER_COMMAND:
 		SV_ClientThink( &svs.clients[args[1]], VMA(2) );
 		return 0;
+	case BOTLIB_UPDATENTITIES:
+		return botlib_export->BotLibUpdateEntities( args[1], VMA(2), VMA(3) );
 
 	case BOTLIB_AAS_BBOX_AREAS:
 		return botlib_export->aas.AAS_BBoxAreas( VMA(1), VMA(2), VMA(3), args[4] );
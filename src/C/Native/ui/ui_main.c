@@ -353,11 +353,34 @@ void Text_PaintChar(float x, float y, float width, float height, float scale, fl
   trap_R_DrawStretchPic( x, y, w, h, s, t, s2, t2, hShader );
 }
 
+static void Text_PaintRun(float x, float y, float useScale, float adjust, fontInfo_t *font, const char *run, int len, int style, const vec4_t color) {
+	float w, h;
+	if (len <= 0) {
+		return;
+	}
+	w = useScale;
+	h = useScale;
+	UI_AdjustFrom640( &x, &y, &w, &h );
+	adjust *= uiInfo.uiDC.xscale;
+	if (style == ITEM_TEXTSTYLE_SHADOWED || style == ITEM_TEXTSTYLE_SHADOWEDMORE) {
+		int ofs = style == ITEM_TEXTSTYLE_SHADOWED ? 1 : 2;
+		colorBlack[3] = color[3];
+		trap_R_SetColor( colorBlack );
+		trap_R_DrawGlyphString(x + ofs * uiInfo.uiDC.xscale, y + ofs * uiInfo.uiDC.yscale, w, h, adjust, font, run, len);
+		colorBlack[3] = 1.0;
+	}
+	trap_R_SetColor( color );
+	trap_R_DrawGlyphString(x, y, w, h, adjust, font, run, len);
+}
+
 void Text_Paint(float x, float y, float scale, vec4_t color, const char *text, float adjust, int limit, int style) {
   int len, count;
 	vec4_t newColor;
 	glyphInfo_t *glyph;
 	float useScale;
+	char run[256];
+	int runLen;
+	float runX;
 	fontInfo_t *font = &uiInfo.uiDC.Assets.textFont;
 	if (scale <= ui_smallFont.value) {
 		font = &uiInfo.uiDC.Assets.smallFont;
@@ -367,56 +390,38 @@ void Text_Paint(float x, float y, float scale, vec4_t color, const char *text, f
 	useScale = scale * font->glyphScale;
   if (text) {
     const char *s = text; // bk001206 - unsigned
-		trap_R_SetColor( color );
 		memcpy(&newColor[0], &color[0], sizeof(vec4_t));
     len = strlen(text);
 		if (limit > 0 && len > limit) {
 			len = limit;
 		}
 		count = 0;
+		// the text between color changes is drawn as a single glyph run
+		runX = x;
+		runLen = 0;
 		while (s && *s && count < len) {
 			glyph = &font->glyphs[(int)*s]; // TTimo: FIXME: getting nasty warnings without the cast, hopefully this doesn't break the VM build
-      //int yadj = Assets.textFont.glyphs[text[i]].bottom + Assets.textFont.glyphs[text[i]].top;
-      //float yadj = scale * (Assets.textFont.glyphs[text[i]].imageHeight - Assets.textFont.glyphs[text[i]].height);
 			if ( Q_IsColorString( s ) ) {
+				Text_PaintRun(runX, y, useScale, adjust, font, run, runLen, style, newColor);
+				runX = x;
+				runLen = 0;
 				memcpy( newColor, g_color_table[ColorIndex(*(s+1))], sizeof( newColor ) );
 				newColor[3] = color[3];
-				trap_R_SetColor( newColor );
 				s += 2;
 				continue;
 			} else {
-				float yadj = useScale * glyph->top;
-				if (style == ITEM_TEXTSTYLE_SHADOWED || style == ITEM_TEXTSTYLE_SHADOWEDMORE) {
-					int ofs = style == ITEM_TEXTSTYLE_SHADOWED ? 1 : 2;
-					colorBlack[3] = newColor[3];
-					trap_R_SetColor( colorBlack );
-					Text_PaintChar(x + ofs, y - yadj + ofs, 
-														glyph->imageWidth,
-														glyph->imageHeight,
-														useScale, 
-														glyph->s,
-														glyph->t,
-														glyph->s2,
-														glyph->t2,
-														glyph->glyph);
-					trap_R_SetColor( newColor );
-					colorBlack[3] = 1.0;
+				if (runLen == sizeof(run)) {
+					Text_PaintRun(runX, y, useScale, adjust, font, run, runLen, style, newColor);
+					runX = x;
+					runLen = 0;
 				}
-				Text_PaintChar(x, y - yadj, 
-													glyph->imageWidth,
-													glyph->imageHeight,
-													useScale, 
-													glyph->s,
-													glyph->t,
-													glyph->s2,
-													glyph->t2,
-													glyph->glyph);
-
+				run[runLen++] = *s;
 				x += (glyph->xSkip * useScale) + adjust;
 				s++;
 				count++;
 			}
     }
+		Text_PaintRun(runX, y, useScale, adjust, font, run, runLen, style, newColor);
 	  trap_R_SetColor( NULL );
   }
 }
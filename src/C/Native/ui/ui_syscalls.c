@@ -170,6 +170,10 @@ void trap_R_DrawStretchPic( float x, float y, float w, float h, float s1, float
 	syscall( UI_R_DRAWSTRETCHPIC, PASSFLOAT(x), PASSFLOAT(y), PASSFLOAT(w), PASSFLOAT(h), PASSFLOAT(s1), PASSFLOAT(t1), PASSFLOAT(s2), PASSFLOAT(t2), hShader );
 }
 
+void trap_R_DrawGlyphString( float x, float y, float xScale, float yScale, float adjust, const fontInfo_t *font, const char *string, int numChars ) {
+	syscall( UI_R_DRAWGLYPHSTRING, PASSFLOAT(x), PASSFLOAT(y), PASSFLOAT(xScale), PASSFLOAT(yScale), PASSFLOAT(adjust), font, string, numChars );
+}
+
 void	trap_R_ModelBounds( clipHandle_t model, vec3_t mins, vec3_t maxs ) {
 	syscall( UI_R_MODELBOUNDS, model, mins, maxs );
 }
@@ -186,6 +186,12 @@ type srfDisplayList_t =
     val mutable surfaceType : surfaceType_t
     val mutable listNum : int
 
+[<Struct>]
+[<StructLayout (LayoutKind.Explicit, Size = 65)>]
+type srfGridMesh_t_lodTable =
+    [<FieldOffset (0)>]
+    val mutable table : byte
+
 [<Struct>]
 [<StructLayout (LayoutKind.Sequential)>]
 type srfGridMesh_t =
@@ -204,6 +210,12 @@ type srfGridMesh_t =
     val mutable height : int
     val mutable widthLodError : nativeptr<single>
     val mutable heightLodError : nativeptr<single>
+    val mutable lodCacheMin : single
+    val mutable lodCacheMax : single
+    val mutable lodWidth : int
+    val mutable lodHeight : int
+    val mutable lodWidthTable : srfGridMesh_t_lodTable
+    val mutable lodHeightTable : srfGridMesh_t_lodTable
     val mutable verts : drawVert_t
 
 [<Struct>]
@@ -730,6 +742,7 @@ type world_t =
     val mutable lightGridBounds2 : int
     
     val mutable lightGridData : nativeptr<byte>
+    val mutable lightGridNormals : nativeptr<single>
     val mutable numClusters : int
     val mutable clusterBytes : int
     val mutable vis : nativeptr<byte>
@@ -844,6 +857,8 @@ type frontEndCounters_t =
     val mutable c_leafs : int
     val mutable c_dlightSurfaces : int
     val mutable c_dlightSurfacesCulled : int
+    val mutable c_lightCacheHits : int
+    val mutable c_lightCacheMisses : int
 
 [<Struct>]
 [<StructLayout (LayoutKind.Sequential)>]